@@ -0,0 +1,178 @@
+// 执行器链路检查：通过 LoopbackTransport 驱动 ActuatorLink，验证断线重连、过期丢弃与合并写出，并给出发送延迟
+// - 正常发送：逐条送达、顺序不变
+// - 写到一半拔线：已写出的命令不重发，其余命令重连后补发
+// - 长时间断线：积压超过 ACTUATOR_STALE_MS 的命令丢弃，之后的命令照常送达
+// - 断线中停止：析构前积压的命令在过期前重连成功仍会送达；过期后不再等待重连
+// - 伪终端回环（仅 POSIX）：经真实的 termios 写路径送达
+// 任一检查失败时返回非零。用法: bench_actuator_link
+#include "ActuatorLink.h"
+#include "LoopbackTransport.h"
+#include "config/Configuration.h"
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+    int g_failures = 0;
+
+    void check(bool condition, const std::string& what) {
+        std::cout << (condition ? "  [ok]   " : "  [FAIL] ") << what << std::endl;
+        if (!condition) g_failures++;
+    }
+
+    bool wait_until(const std::function<bool()>& done, int timeout_ms) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        while (!done()) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    std::string received_bytes(const LoopbackTransport& loopback) {
+        std::string bytes;
+        for (const auto& r : loopback.received()) bytes.push_back(r.byte);
+        return bytes;
+    }
+
+    // 转发到共享的模拟器，链路析构后仍可读取收到的字节
+    class SharedTransport : public ActuatorTransport {
+    public:
+        explicit SharedTransport(std::shared_ptr<LoopbackTransport> target) : m_target(std::move(target)) {}
+        bool open() override { return m_target->open(); }
+        void close() override { m_target->close(); }
+        bool isOpen() const override { return m_target->isOpen(); }
+        size_t write(const char* data, size_t size) override { return m_target->write(data, size); }
+        std::string name() const override { return m_target->name(); }
+        std::string lastError() const override { return m_target->lastError(); }
+
+    private:
+        std::shared_ptr<LoopbackTransport> m_target;
+    };
+
+    // 链路与其通道：保留模拟器用于注入断线和读取收到的字节
+    struct Fixture {
+        std::shared_ptr<LoopbackTransport> loopback;
+        std::unique_ptr<ActuatorLink> link;
+
+        Fixture(LoopbackTransport::Mode mode, int baud) {
+            loopback = std::make_shared<LoopbackTransport>(mode, baud, Config::ACTUATOR_WRITE_TIMEOUT_MS);
+            link = std::make_unique<ActuatorLink>(std::make_unique<SharedTransport>(loopback));
+            wait_until([this] { return link->isConnected(); }, 1000);
+        }
+
+        // 等待发送线程处理完 expected 条命令（写出或丢弃）
+        bool drain(uint64_t expected, int timeout_ms = 5000) const {
+            return wait_until([&] {
+                const ActuatorLink::Stats s = link->stats();
+                return s.sent + s.dropped_stale >= expected;
+            }, timeout_ms);
+        }
+    };
+
+    void steady_sending() {
+        std::cout << "steady sending" << std::endl;
+        Fixture f(LoopbackTransport::Mode::InProcess, Config::ACTUATOR_BAUD);
+        const std::string codes = "ABCDABCDABCDABCDABCD";
+        for (char code : codes) {
+            f.link->send(code);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        check(f.drain(codes.size()), "all commands processed");
+        check(received_bytes(*f.loopback) == codes, "delivered once each, in order");
+        f.link->report();
+    }
+
+    void disconnect_mid_batch() {
+        std::cout << "disconnect in the middle of a batch" << std::endl;
+        // 低波特率拉长单字节写：第一条命令写出期间后续命令积压为一批
+        Fixture f(LoopbackTransport::Mode::InProcess, 1200);
+        f.link->send('x');
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        f.loopback->disconnect(0, 3);
+        const std::string burst = "abcdefghij";
+        for (char code : burst) f.link->send(code);
+
+        check(f.drain(1 + burst.size()), "all commands processed");
+        const ActuatorLink::Stats s = f.link->stats();
+        check(s.dropped_stale == 0, "nothing dropped as stale");
+        check(s.write_failures == 1 && s.reconnects == 1, "one failed write, one reconnect");
+        check(received_bytes(*f.loopback) == "x" + burst, "sent prefix not repeated, remainder resent in order");
+        check(s.sent == 1 + burst.size(), "sent counter matches delivered bytes");
+        f.link->report();
+    }
+
+    void long_outage() {
+        std::cout << "outage longer than ACTUATOR_STALE_MS" << std::endl;
+        Fixture f(LoopbackTransport::Mode::InProcess, Config::ACTUATOR_BAUD);
+        // 重连退避 100 + 200 + 400 ms，远超过期时间
+        f.loopback->disconnect(3);
+        for (char code : std::string("abc")) f.link->send(code);
+        check(wait_until([&] { return f.link->stats().dropped_stale == 3; }, 5000), "commands queued during the outage dropped");
+        check(wait_until([&] { return f.link->isConnected(); }, 5000), "reconnected after the outage");
+        f.link->send('z');
+        check(f.drain(4), "command after the outage processed");
+        check(received_bytes(*f.loopback) == "z", "only the fresh command delivered");
+        f.link->report();
+    }
+
+    // 析构耗时（毫秒）
+    long long destroy_link(Fixture& f) {
+        const auto begin = std::chrono::steady_clock::now();
+        f.link.reset();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    void shutdown_during_outage() {
+        std::cout << "shutdown while the link is down" << std::endl;
+        {
+            // 一次重连失败（退避 100 ms），积压的命令在过期前送达
+            Fixture f(LoopbackTransport::Mode::InProcess, Config::ACTUATOR_BAUD);
+            f.loopback->disconnect(1);
+            f.link->send('a');
+            f.link->send('b');
+            destroy_link(f);
+            check(received_bytes(*f.loopback) == "ab", "commands queued before shutdown delivered after reconnecting");
+        }
+        {
+            // 重连退避远超过期时间：命令过期后即退出，不等端口恢复
+            Fixture f(LoopbackTransport::Mode::InProcess, Config::ACTUATOR_BAUD);
+            f.loopback->disconnect(5);
+            f.link->send('a');
+            const long long ms = destroy_link(f);
+            check(received_bytes(*f.loopback).empty(), "stale command not delivered");
+            check(ms < Config::ACTUATOR_STALE_MS + Config::ACTUATOR_RECONNECT_MIN_MS * 2,
+                  "shutdown returned once the backlog went stale (" + std::to_string(ms) + " ms)");
+        }
+    }
+
+#ifndef _WIN32
+    void pty_loopback() {
+        std::cout << "pty loopback" << std::endl;
+        Fixture f(LoopbackTransport::Mode::Pty, Config::ACTUATOR_BAUD);
+        if (!f.link->isConnected()) {
+            std::cout << "  [skip] " << f.loopback->lastError() << std::endl;
+            return;
+        }
+        const std::string codes = "ABCD";
+        for (char code : codes) f.link->send(code);
+        check(f.drain(codes.size()), "all commands written");
+        check(wait_until([&] { return received_bytes(*f.loopback) == codes; }, 1000), "read back from the pty master");
+    }
+#endif
+}
+
+int main() {
+    steady_sending();
+    disconnect_mid_batch();
+    long_outage();
+    shutdown_during_outage();
+#ifndef _WIN32
+    pty_loopback();
+#endif
+    std::cout << (g_failures ? "FAILED: " + std::to_string(g_failures) + " check(s)" : std::string("all checks passed")) << std::endl;
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,122 @@
+// 指派求解器对比：第三方 Munkres（vector<vector<double>>）、AssignmentSolver（扁平 float + 复用工作区）
+// 与 GatedAssociator（网格索引 + 分量拆分）
+// 场景模拟跟踪：轨迹预测位置 + 带噪声的检测，超出门限的配对禁止
+// 用法: bench_assignment [iterations]
+#include "AssignmentSolver.h"
+#include "GatedAssociator.h"
+#include "hungarian/Hungarian.h"
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr double GATE = 150.0;
+    constexpr double MUNKRES_FORBIDDEN = 1e6;
+
+    struct Scene {
+        int rows, cols;
+        std::vector<float> flat;
+        std::vector<cv::Point2f> tracks, detections;
+    };
+
+    Scene make_scene(int rows, int cols, std::mt19937& rng) {
+        // 物体密度与传送带上的苹果相近：大约每 200 像素见方一个
+        const float extent = 200.0f * std::sqrt((float)std::max(rows, cols));
+        std::uniform_real_distribution<float> pos(0.0f, extent);
+        std::normal_distribution<float> noise(0.0f, 25.0f);
+        std::vector<float> tx(rows), ty(rows);
+        for (int i = 0; i < rows; ++i) { tx[i] = pos(rng); ty[i] = pos(rng); }
+        Scene s{rows, cols, std::vector<float>((size_t)rows * cols), {}, {}};
+        for (int i = 0; i < rows; ++i) s.tracks.emplace_back(tx[i], ty[i]);
+        for (int j = 0; j < cols; ++j) {
+            float dx, dy;
+            if (j < rows) { dx = tx[j] + noise(rng); dy = ty[j] + noise(rng); }
+            else { dx = pos(rng); dy = pos(rng); }
+            s.detections.emplace_back(dx, dy);
+            for (int i = 0; i < rows; ++i) s.flat[(size_t)i * cols + j] = std::hypot(tx[i] - dx, ty[i] - dy);
+        }
+        return s;
+    }
+
+    // 只统计门限内的配对，两种实现在最优解意义下应一致
+    void score(const Scene& s, const std::vector<int>& assignment, int& matched, double& cost) {
+        matched = 0;
+        cost = 0.0;
+        for (int i = 0; i < s.rows; ++i) {
+            const int j = assignment[i];
+            if (j < 0) continue;
+            const double c = s.flat[(size_t)i * s.cols + j];
+            if (c >= GATE) continue;
+            matched++;
+            cost += c;
+        }
+    }
+
+    double time_us(int iterations, const std::function<void()>& fn) {
+        fn();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) fn();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int base_iterations = argc > 1 ? std::stoi(argv[1]) : 2000;
+    const int sizes[][2] = {{2, 2}, {3, 5}, {5, 5}, {10, 10}, {20, 15}, {20, 20}, {50, 50}, {100, 100}, {150, 200}, {200, 200}};
+
+    std::mt19937 rng(7);
+    AssignmentSolver solver;
+    GatedAssociator associator;
+    std::vector<int> fast_assignment, gated_assignment, munkres_assignment;
+
+    std::cout << std::left << std::setw(10) << "size" << std::setw(14) << "munkres_us" << std::setw(14) << "solver_us"
+              << std::setw(14) << "gated_us" << std::setw(12) << "components" << "agree" << std::endl;
+    for (const auto& size : sizes) {
+        const Scene scene = make_scene(size[0], size[1], rng);
+        const int iterations = std::max(5, base_iterations / std::max(1, size[0] * size[1] / 100));
+
+        // 与原 TrackManager 相同：每次构造 vector<vector<double>>，门限外代价置为极大值
+        double munkres_us = time_us(iterations, [&] {
+            std::vector<std::vector<double>> cost(scene.rows, std::vector<double>(scene.cols, MUNKRES_FORBIDDEN));
+            for (int i = 0; i < scene.rows; ++i)
+                for (int j = 0; j < scene.cols; ++j) {
+                    const float c = scene.flat[(size_t)i * scene.cols + j];
+                    if (c < GATE) cost[i][j] = c;
+                }
+            HungarianAlgorithm munkres;
+            munkres.Solve(cost, munkres_assignment);
+        });
+        // 稠密路径同样包含逐对求距离
+        double solver_us = time_us(iterations, [&] {
+            float* cost = solver.cost_buffer(scene.rows, scene.cols);
+            for (int i = 0; i < scene.rows; ++i)
+                for (int j = 0; j < scene.cols; ++j)
+                    cost[i * scene.cols + j] = std::hypot(scene.tracks[i].x - scene.detections[j].x,
+                                                          scene.tracks[i].y - scene.detections[j].y);
+            solver.solve(cost, scene.rows, scene.cols, fast_assignment, GATE);
+        });
+        double gated_us = time_us(iterations, [&] {
+            associator.associate(scene.tracks, scene.detections, (float)GATE, gated_assignment);
+        });
+
+        int munkres_matched, solver_matched, gated_matched;
+        double munkres_cost, solver_cost, gated_cost;
+        score(scene, munkres_assignment, munkres_matched, munkres_cost);
+        score(scene, fast_assignment, solver_matched, solver_cost);
+        score(scene, gated_assignment, gated_matched, gated_cost);
+        const bool agree = munkres_matched == solver_matched && std::abs(munkres_cost - solver_cost) < 1e-2 &&
+                           munkres_matched == gated_matched && std::abs(munkres_cost - gated_cost) < 1e-2;
+
+        std::cout << std::left << std::setw(10) << (std::to_string(size[0]) + "x" + std::to_string(size[1]))
+                  << std::fixed << std::setprecision(2) << std::setw(14) << munkres_us << std::setw(14) << solver_us
+                  << std::setw(14) << gated_us << std::setw(12) << associator.last_stats().components
+                  << (agree ? "yes" : "NO") << " (" << solver_matched << " matched)" << std::endl;
+    }
+    return 0;
+}
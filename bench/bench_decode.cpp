@@ -0,0 +1,159 @@
+// 逐编解码方式的帧解码吞吐：PNG（两种压缩级别）/ JPEG（整帧与缩小尺度）/ 录制文件三种负载
+// 压缩数据预先放在内存或页缓存中，只计解码，不计磁盘；多线程列为 threads 个线程各自解码不同帧时的总吞吐
+// 用法: bench_decode [dataset_dir | image_path] [frames] [threads]
+#include "FrameDecoder.h"
+#include "FrameRecording.h"
+#include "config/Configuration.h"
+#include "config/RuntimeConfig.h"
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    struct Codec {
+        std::string name;
+        double mb_per_frame;
+        std::function<bool(size_t, cv::Mat&)> decode; // 解码第 i 帧，线程安全
+    };
+
+    std::vector<cv::Mat> load_frames(const std::string& source, int count) {
+        std::vector<cv::Mat> frames;
+        if (!source.empty() && fs::is_directory(source)) {
+            for (const auto& file : list_image_files(source)) {
+                if ((int)frames.size() >= count) break;
+                cv::Mat frame = cv::imread(file, cv::IMREAD_COLOR);
+                if (!frame.empty()) frames.push_back(frame);
+            }
+        } else if (!source.empty()) {
+            cv::Mat frame = cv::imread(source, cv::IMREAD_COLOR);
+            if (!frame.empty()) frames.assign(count, frame);
+        }
+        if (frames.empty()) {
+            // 平滑背景 + 苹果色圆斑，压缩率接近真实场景（纯噪声几乎不可压缩）
+            cv::RNG rng(42);
+            for (int f = 0; f < count; ++f) {
+                cv::Mat frame(1080, 1920, CV_8UC3);
+                cv::randu(frame, cv::Scalar::all(40), cv::Scalar::all(90));
+                cv::GaussianBlur(frame, frame, {0, 0}, 3.0);
+                for (int i = 0; i < 40; ++i) {
+                    cv::circle(frame, {rng.uniform(0, 1920), rng.uniform(0, 1080)}, rng.uniform(30, 60),
+                               cv::Scalar(rng.uniform(0, 80), rng.uniform(120, 230), rng.uniform(180, 256)), cv::FILLED);
+                }
+                frames.push_back(frame);
+            }
+        }
+        return frames;
+    }
+
+    Codec in_memory(const std::string& name, const std::string& ext, const std::vector<int>& params, int flags,
+                    const std::vector<cv::Mat>& frames, std::vector<std::vector<uchar>>& storage) {
+        size_t bytes = 0;
+        storage.resize(frames.size());
+        for (size_t i = 0; i < frames.size(); ++i) {
+            cv::imencode(ext, frames[i], storage[i], params);
+            bytes += storage[i].size();
+        }
+        const auto* buffers = &storage;
+        return {name, bytes / (1024.0 * 1024.0) / frames.size(), [buffers, flags](size_t i, cv::Mat& out) {
+            cv::imdecode((*buffers)[i % buffers->size()], flags, &out);
+            return !out.empty();
+        }};
+    }
+
+    Codec recorded(const std::string& name, const std::string& path, Config::RecordingPayload payload,
+                   const std::vector<cv::Mat>& frames, std::unique_ptr<FrameDecoder>& decoder) {
+        {
+            RecordingWriter writer(path, payload, recording_crop_for_lanes(RuntimeConfig::current()->lanes));
+            for (size_t i = 0; i < frames.size(); ++i) writer.write(frames[i], (int64_t)(i * 1e9 / Config::VIDEO_FPS));
+        }
+        decoder = std::make_unique<FrameDecoder>(path, false);
+        const double mb = fs::file_size(path) / (1024.0 * 1024.0) / frames.size();
+        const FrameDecoder* d = decoder.get();
+        return {name, mb, [d](size_t i, cv::Mat& out) { return d->decode(i % d->size(), out); }};
+    }
+
+    // 单线程每帧毫秒数
+    double single_thread_ms(const Codec& codec, size_t frames) {
+        cv::Mat out;
+        codec.decode(0, out); // 预热
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < frames; ++i) codec.decode(i, out);
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+    }
+
+    // threads 个线程分摊 frames × threads 帧的总吞吐（帧/秒）
+    double multi_thread_fps(const Codec& codec, size_t frames, unsigned int threads) {
+        std::atomic<size_t> next = {0};
+        const size_t total = frames * threads;
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                cv::Mat out;
+                for (size_t i = next++; i < total; i = next++) codec.decode(i, out);
+            });
+        }
+        for (auto& w : workers) w.join();
+        return total / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const std::string source = argc > 1 ? argv[1] : "";
+    const int frame_count = argc > 2 ? std::stoi(argv[2]) : 30;
+    const unsigned int threads = argc > 3 ? (unsigned int)std::stoi(argv[3]) : (std::max)(1u, std::thread::hardware_concurrency() / 2);
+    cv::setNumThreads(1);
+
+    const std::vector<cv::Mat> frames = load_frames(source, frame_count);
+    std::cout << frames.size() << " frames " << frames[0].cols << "x" << frames[0].rows << ", " << threads << " threads" << std::endl;
+
+    const fs::path temp_dir = fs::temp_directory_path() / "bench_decode";
+    fs::create_directories(temp_dir);
+    std::vector<std::vector<uchar>> png1, png3, jpeg;
+    std::unique_ptr<FrameDecoder> raw, roi, arec_png;
+    std::vector<Codec> codecs = {
+        in_memory("png (level 1)", ".png", {cv::IMWRITE_PNG_COMPRESSION, 1}, cv::IMREAD_COLOR, frames, png1),
+        in_memory("png (level 3)", ".png", {cv::IMWRITE_PNG_COMPRESSION, 3}, cv::IMREAD_COLOR, frames, png3),
+        in_memory("jpg (q95)", ".jpg", {cv::IMWRITE_JPEG_QUALITY, 95}, cv::IMREAD_COLOR, frames, jpeg),
+    };
+    // 同一批 JPEG 数据按 1/2、1/4 尺度解码（LOSSY_JPEG_DECODE_SCALE 的有损模式）
+    const auto* jpeg_buffers = &jpeg;
+    const double jpeg_mb = codecs.back().mb_per_frame;
+    for (int scale : {2, 4}) {
+        const int flags = scale == 2 ? cv::IMREAD_REDUCED_COLOR_2 : cv::IMREAD_REDUCED_COLOR_4;
+        codecs.push_back({"jpg 1/" + std::to_string(scale), jpeg_mb, [jpeg_buffers, flags](size_t i, cv::Mat& out) {
+            cv::imdecode((*jpeg_buffers)[i % jpeg_buffers->size()], flags, &out);
+            return !out.empty();
+        }});
+    }
+    codecs.push_back(recorded("arec:raw", (temp_dir / "raw.arec").string(), Config::RecordingPayload::Raw, frames, raw));
+    codecs.push_back(recorded("arec:roi", (temp_dir / "roi.arec").string(), Config::RecordingPayload::RoiCrop, frames, roi));
+    codecs.push_back(recorded("arec:png", (temp_dir / "png.arec").string(), Config::RecordingPayload::Png, frames, arec_png));
+
+    std::cout << std::left << std::setw(16) << "codec" << std::right << std::setw(12) << "MB/frame" << std::setw(12) << "ms/frame"
+              << std::setw(12) << "fps x1" << std::setw(12) << "fps xN" << std::endl;
+    std::cout << std::fixed;
+    for (const auto& codec : codecs) {
+        const double ms = single_thread_ms(codec, frames.size());
+        const double fps = multi_thread_fps(codec, frames.size(), threads);
+        std::cout << std::left << std::setw(16) << codec.name << std::right << std::setprecision(3) << std::setw(12) << codec.mb_per_frame
+                  << std::setw(12) << ms << std::setprecision(1) << std::setw(12) << 1000.0 / ms << std::setw(12) << fps << std::endl;
+    }
+
+    raw.reset();
+    roi.reset();
+    arec_png.reset();
+    std::error_code ec;
+    fs::remove_all(temp_dir, ec);
+    return 0;
+}
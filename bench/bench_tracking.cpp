@@ -0,0 +1,190 @@
+// 运动模型对比：VelocityBlend 与 Kalman 的关联吞吐量、ID 切换率与轨迹碎片化
+// - 无参数：合成传送带序列（已知真值，含随机遮挡），统计 ID 切换次数
+// - 传入数据集目录：先逐帧分割得到检测，再用两种模型分别回放（无真值，以短轨迹数衡量碎片化）
+// 用法: bench_tracking [dataset_dir ...]
+#include "TrackManager.h"
+#include "ImageProcessor.h"
+#include "config/Configuration.h"
+#include "config/RuntimeConfig.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr int SYNTHETIC_FRAMES = 3000;
+
+    // TrackManager 的逐事件日志会淹没基准输出，运行期间丢弃
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return c; }
+    };
+
+    struct Sequence {
+        std::vector<std::vector<Detection>> frames;
+        bool has_truth = false; // 合成序列中 Detection::label_id 即真值物体编号
+    };
+
+    struct Result {
+        double update_us = 0.0;
+        int tracks_created = 0;
+        int id_switches = 0;
+        int fragmented_objects = 0; // 被多于一条轨迹覆盖的真值物体
+        int short_tracks = 0;       // 长度不足 MIN_TRACK_LENGTH_FOR_STATS 的轨迹
+    };
+
+    Sequence make_synthetic_sequence() {
+        const RuntimeConfig::SnapshotPtr config = RuntimeConfig::current();
+        const cv::Rect roi = config->lanes[0].roi;
+        const float base_speed = std::hypot(config->initial_movement.x, config->initial_movement.y);
+        const cv::Point2f dir = config->initial_movement * (1.0f / base_speed);
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::normal_distribution<float> noise(0.0f, 2.0f);
+
+        struct Object { int id; cv::Point2f pos; cv::Point2f vel; float size; int occluded; };
+        std::vector<Object> objects;
+        Sequence seq;
+        seq.has_truth = true;
+        int next_id = 0;
+        for (int f = 0; f < SYNTHETIC_FRAMES; ++f) {
+            // 从运动方向的上游边缘进入
+            if (unit(rng) < 0.12f) {
+                Object o;
+                o.id = next_id++;
+                const float across = unit(rng);
+                if (std::abs(dir.y) >= std::abs(dir.x)) {
+                    o.pos = {roi.x + across * roi.width, dir.y < 0 ? (float)(roi.y + roi.height - 1) : (float)roi.y};
+                } else {
+                    o.pos = {dir.x < 0 ? (float)(roi.x + roi.width - 1) : (float)roi.x, roi.y + across * roi.height};
+                }
+                o.vel = dir * (base_speed * (0.7f + 0.6f * unit(rng)));
+                o.size = 50.0f + 20.0f * unit(rng);
+                o.occluded = 0;
+                objects.push_back(o);
+            }
+
+            std::vector<Detection> detections;
+            for (auto& o : objects) {
+                // 传送带速度缓慢变化，偶尔被枝叶 / 相邻苹果遮挡 1~4 帧
+                o.vel = o.vel * (1.0f + 0.02f * (unit(rng) - 0.5f));
+                o.pos += o.vel;
+                if (o.occluded > 0) o.occluded--;
+                else if (unit(rng) < 0.05f) o.occluded = 1 + (int)(unit(rng) * 4);
+                if (o.occluded > 0 || !roi.contains(o.pos)) continue;
+                Detection det;
+                det.label_id = o.id;
+                det.roi_id = 0;
+                det.centroid = {o.pos.x + noise(rng), o.pos.y + noise(rng)};
+                const int w = (int)(o.size + noise(rng)), h = (int)(o.size + noise(rng));
+                det.bbox = cv::Rect((int)det.centroid.x - w / 2, (int)det.centroid.y - h / 2, w, h);
+                det.area = w * h;
+                detections.push_back(det);
+            }
+            objects.erase(std::remove_if(objects.begin(), objects.end(),
+                [&](const Object& o) { return !roi.contains(o.pos); }), objects.end());
+            seq.frames.push_back(std::move(detections));
+        }
+        return seq;
+    }
+
+    Sequence load_dataset_sequence(const std::string& directory) {
+        std::vector<std::string> files;
+        for (const auto& entry : fs::directory_iterator(directory)) {
+            if (entry.path().extension() == ".png" || entry.path().extension() == ".jpg") files.push_back(entry.path().string());
+        }
+        std::sort(files.begin(), files.end());
+        Sequence seq;
+        for (int i = 0; i < (int)files.size(); ++i) {
+            ProducerTask task{i, cv::imread(files[i])};
+            if (task.image.empty()) {
+                seq.frames.emplace_back();
+                continue;
+            }
+            seq.frames.push_back(ImageProcessor::process_frame(task).detections);
+        }
+        return seq;
+    }
+
+    Result run(const Sequence& seq, Config::MotionModel model) {
+        Result r;
+        TrackManager manager(model);
+        TrackTable tracks((int)RuntimeConfig::current()->lanes.size());
+        std::map<int, int> track_length;      // unique_id -> 命中帧数
+        std::map<int, int> truth_to_track;    // 真值物体 -> 上一次关联到的轨迹
+        std::map<int, std::vector<int>> truth_tracks;
+
+        NullBuffer null_buffer;
+        std::streambuf* saved = std::cout.rdbuf(&null_buffer);
+        double total_us = 0.0;
+        for (int f = 0; f < (int)seq.frames.size(); ++f) {
+            ConsumerResult result{f, cv::Mat(), seq.frames[f], cv::Mat()};
+            auto start = std::chrono::steady_clock::now();
+            manager.update(result, tracks);
+            total_us += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            manager.takeScheduledActions();
+
+            const TrackTable::Columns& c = tracks.columns();
+            for (int i = 0; i < tracks.size(); ++i) {
+                if (c.missed_frames[i] != 0) continue;
+                track_length[c.unique_id[i]]++;
+                if (!seq.has_truth) continue;
+                const int truth = c.label_id[i];
+                auto it = truth_to_track.find(truth);
+                if (it != truth_to_track.end() && it->second != c.unique_id[i]) r.id_switches++;
+                truth_to_track[truth] = c.unique_id[i];
+                auto& ids = truth_tracks[truth];
+                if (std::find(ids.begin(), ids.end(), c.unique_id[i]) == ids.end()) ids.push_back(c.unique_id[i]);
+            }
+        }
+        std::cout.rdbuf(saved);
+
+        r.update_us = total_us / std::max<size_t>(1, seq.frames.size());
+        r.tracks_created = (int)track_length.size();
+        for (const auto& [id, length] : track_length) {
+            if (length < Config::MIN_TRACK_LENGTH_FOR_STATS) r.short_tracks++;
+        }
+        for (const auto& [truth, ids] : truth_tracks) {
+            if (ids.size() > 1) r.fragmented_objects++;
+        }
+        return r;
+    }
+
+    void report(const std::string& name, const Sequence& seq) {
+        size_t detections = 0;
+        for (const auto& f : seq.frames) detections += f.size();
+        std::cout << "\n" << name << ": " << seq.frames.size() << " frames, " << detections << " detections" << std::endl;
+        std::cout << std::left << std::setw(16) << "model" << std::setw(12) << "us/frame" << std::setw(10) << "tracks"
+                  << std::setw(14) << "short_tracks";
+        if (seq.has_truth) std::cout << std::setw(14) << "id_switches" << "fragmented_objects";
+        std::cout << std::endl;
+        const std::pair<const char*, Config::MotionModel> models[] = {
+            {"velocity_blend", Config::MotionModel::VelocityBlend}, {"kalman", Config::MotionModel::Kalman}};
+        for (const auto& [label, model] : models) {
+            const Result r = run(seq, model);
+            std::cout << std::left << std::setw(16) << label << std::fixed << std::setprecision(2) << std::setw(12) << r.update_us
+                      << std::setw(10) << r.tracks_created << std::setw(14) << r.short_tracks;
+            if (seq.has_truth) std::cout << std::setw(14) << r.id_switches << r.fragmented_objects;
+            std::cout << std::endl;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        report("synthetic conveyor", make_synthetic_sequence());
+        return 0;
+    }
+    ImageProcessor::initialize();
+    for (int i = 1; i < argc; ++i) report(argv[i], load_dataset_sequence(argv[i]));
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include "ActuationDispatcher.h"
+#include "config/Configuration.h"
+#include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <timeapi.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+    // 提高调度线程优先级；失败（如无权限）时只打印警告，继续以普通优先级运行
+    void raise_thread_priority() {
+        if (!Config::ACTUATION_REALTIME_PRIORITY) return;
+#ifdef _WIN32
+        if (!SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+            std::cout << "[Warning] Could not raise actuation thread priority." << std::endl;
+        }
+#else
+        sched_param param{};
+        param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+            std::cout << "[Warning] Could not switch actuation thread to SCHED_FIFO, using normal priority." << std::endl;
+        }
+#endif
+    }
+
+#ifdef _WIN32
+    // Windows 默认计时器精度约 15.6 ms，调度期间提高到 1 ms，否则睡眠会大幅越过截止时间
+    struct TimerResolution {
+        TimerResolution() { timeBeginPeriod(1); }
+        ~TimerResolution() { timeEndPeriod(1); }
+    };
+#endif
+}
+
+ActuationDispatcher::ActuationDispatcher(FireFn fire) : m_fire(std::move(fire)) {}
+
+void ActuationDispatcher::schedule(const PendingAction& action) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_closed) return;
+        m_heap.push({action, m_next_sequence++});
+    }
+    m_cv.notify_one();
+}
+
+void ActuationDispatcher::close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+    }
+    m_cv.notify_one();
+}
+
+void ActuationDispatcher::run() {
+    raise_thread_priority();
+#ifdef _WIN32
+    TimerResolution timer_resolution;
+#endif
+    const auto spin = std::chrono::microseconds(Config::ACTUATION_SPIN_US);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        if (m_heap.empty()) {
+            if (m_closed) break;
+            m_cv.wait(lock, [this] { return m_closed || !m_heap.empty(); });
+            continue;
+        }
+
+        const auto deadline = m_heap.top().action.trigger_time;
+        if (std::chrono::steady_clock::now() < deadline - spin) {
+            // 粗睡眠：期间排入更早的动作会被唤醒并重新计算截止时间
+            m_cv.wait_until(lock, deadline - spin);
+            continue;
+        }
+
+        // 最后一段自旋等待，不持锁，避免阻塞 schedule()
+        lock.unlock();
+        while (std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+        lock.lock();
+
+        // 自旋期间堆顶只可能换成更早（同样已到期）的动作
+        const Entry entry = m_heap.top();
+        m_heap.pop();
+        lock.unlock();
+        const auto fired_at = std::chrono::steady_clock::now();
+        m_fire(entry.action);
+        lock.lock();
+        m_lateness_us[entry.action.action_type].record(
+            std::chrono::duration_cast<std::chrono::microseconds>(fired_at - entry.action.trigger_time).count());
+    }
+}
+
+std::vector<ActuationDispatcher::Stats> ActuationDispatcher::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<Stats> result;
+    for (const auto& entry : m_lateness_us) result.push_back({entry.first, entry.second});
+    return result;
+}
+
+void ActuationDispatcher::report() const {
+    for (const auto& s : stats()) {
+        const LatencyHistogram& h = s.lateness_us;
+        std::cout << "[Info] Actuation '" << s.action_code << "': fired=" << h.count()
+                  << " lateness_us p50=" << h.percentile(50) << " p99=" << h.percentile(99)
+                  << " max=" << h.max() << " mean=" << h.mean() << std::endl;
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef ACTUATIONDISPATCHER_H
+#define ACTUATIONDISPATCHER_H
+
+#include "utils/DataTypes.h"
+#include "utils/LatencyHistogram.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+// 执行器调度：按触发时间排序的最小堆 + 专用线程。
+// 线程睡眠到最早的截止时间前 Config::ACTUATION_SPIN_US，再自旋到截止时间后立即调用 fire，
+// 触发时刻与跟踪线程的帧率、显示 / 编码的卡顿无关。
+// 每个执行器代码记录一份迟到直方图（实际触发 - 计划触发，微秒）。
+class ActuationDispatcher {
+public:
+    using FireFn = std::function<void(const PendingAction&)>;
+
+    struct Stats {
+        char action_code;
+        LatencyHistogram lateness_us;
+    };
+
+    explicit ActuationDispatcher(FireFn fire);
+
+    // 任意线程调用；比当前堆顶更早的动作会唤醒调度线程重新计时
+    void schedule(const PendingAction& action);
+    // 不再接受新动作；run() 按时触发完剩余动作后返回
+    void close();
+    // 调度线程主循环（由 Pipeline 作为独立阶段运行）
+    void run();
+
+    std::vector<Stats> stats() const;
+    void report() const;
+
+private:
+    struct Entry {
+        PendingAction action;
+        uint64_t sequence; // 截止时间相同时保持排定顺序
+    };
+    struct Later {
+        bool operator()(const Entry& a, const Entry& b) const {
+            if (a.action.trigger_time != b.action.trigger_time) return a.action.trigger_time > b.action.trigger_time;
+            return a.sequence > b.sequence;
+        }
+    };
+
+    FireFn m_fire;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::priority_queue<Entry, std::vector<Entry>, Later> m_heap;
+    uint64_t m_next_sequence = 0;
+    bool m_closed = false;
+    std::map<char, LatencyHistogram> m_lateness_us;
+};
+
+#endif //ACTUATIONDISPATCHER_H
@@ -0,0 +1,145 @@
+#include "ActuatorLink.h"
+#include "config/Configuration.h"
+#include "utils/Trace.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+ActuatorLink::ActuatorLink(std::unique_ptr<ActuatorTransport> transport)
+    : m_transport(std::move(transport)), m_name(m_transport->name()),
+      m_queue(Config::ACTUATOR_QUEUE_CAPACITY, OverflowPolicy::DropNewest) {
+    // 连接在发送线程上进行，端口不存在或暂时打不开都不会拖住启动
+    m_thread = std::thread([this] { run(); });
+}
+
+ActuatorLink::~ActuatorLink() {
+    // 先关闭队列，发送线程照常写完剩余命令；断线时只重连到这些命令过期为止，不会无限期拖住退出
+    m_queue.close();
+    {
+        std::lock_guard<std::mutex> lock(m_closing_mutex);
+        m_closing = true;
+    }
+    m_closing_cv.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+bool ActuatorLink::send(char code) {
+    if (m_queue.push({code, std::chrono::steady_clock::now()})) return true;
+    std::lock_guard<std::mutex> lock(m_stats_mutex);
+    m_stats.dropped_full++;
+    return false;
+}
+
+bool ActuatorLink::ensure_open(std::chrono::steady_clock::time_point give_up_at) {
+    if (m_transport->isOpen()) return true;
+    auto backoff = std::chrono::milliseconds(Config::ACTUATOR_RECONNECT_MIN_MS);
+    bool warned = false;
+    auto given_up = [&] { return m_closing && std::chrono::steady_clock::now() >= give_up_at; };
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(m_closing_mutex);
+            if (given_up()) return false;
+        }
+        if (m_transport->open()) {
+            if (m_was_connected) {
+                std::lock_guard<std::mutex> lock(m_stats_mutex);
+                m_stats.reconnects++;
+            }
+            m_was_connected = true;
+            m_connected = true;
+            std::cout << "[Info] Actuator link connected on " << m_name << std::endl;
+            return true;
+        }
+        // 每次断线只提示一次，之后静默重试
+        if (!warned) {
+            std::cout << "[Warning] Actuator " << m_name << " unavailable (" << m_transport->lastError()
+                      << "), retrying in background." << std::endl;
+            warned = true;
+        }
+        // 关闭前按退避间隔等待；关闭后最迟在 give_up_at 醒来
+        std::unique_lock<std::mutex> lock(m_closing_mutex);
+        const auto retry_at = std::chrono::steady_clock::now() + backoff;
+        while (std::chrono::steady_clock::now() < retry_at && !given_up()) {
+            m_closing_cv.wait_until(lock, m_closing ? (std::min)(retry_at, give_up_at) : retry_at);
+        }
+        backoff = (std::min)(backoff * 2, std::chrono::milliseconds(Config::ACTUATOR_RECONNECT_MAX_MS));
+    }
+}
+
+void ActuatorLink::run() {
+    const auto stale_after = std::chrono::milliseconds(Config::ACTUATOR_STALE_MS);
+    std::vector<Command> batch;
+    std::string bytes;
+    Trace::name_thread("actuator-link");
+    // 启动时没有待发命令：链路关闭后不再重试
+    ensure_open({});
+
+    Command command;
+    while (m_queue.wait_and_pop(command)) {
+        // 上一次 write 期间积压的命令合并为一次写出
+        batch.clear();
+        batch.push_back(command);
+        while (batch.size() < Config::ACTUATOR_MAX_BATCH && m_queue.try_pop(command)) batch.push_back(command);
+
+        while (!batch.empty()) {
+            // 批内按入队顺序排列，最后一条过期后整批都已过期
+            const bool open = ensure_open(batch.back().enqueued + stale_after);
+            const auto now = std::chrono::steady_clock::now();
+            const auto fresh_end = std::remove_if(batch.begin(), batch.end(), [&](const Command& c) {
+                return !open || now - c.enqueued > stale_after;
+            });
+            if (fresh_end != batch.end()) {
+                std::lock_guard<std::mutex> lock(m_stats_mutex);
+                m_stats.dropped_stale += (uint64_t)(batch.end() - fresh_end);
+            }
+            batch.erase(fresh_end, batch.end());
+            if (batch.empty()) break;
+
+            bytes.clear();
+            for (const auto& c : batch) bytes.push_back(c.code);
+            const auto write_start = std::chrono::steady_clock::now();
+            const size_t written = (std::min)(m_transport->write(bytes.data(), bytes.size()), bytes.size());
+            const auto write_end = std::chrono::steady_clock::now();
+            Trace::record(Trace::Span::SerialWrite, write_start, write_end);
+
+            {
+                std::lock_guard<std::mutex> lock(m_stats_mutex);
+                m_stats.batches++;
+                m_stats.sent += written;
+                if (written < bytes.size()) m_stats.write_failures++;
+                m_stats.write_us.record(std::chrono::duration_cast<std::chrono::microseconds>(write_end - write_start).count());
+                for (size_t i = 0; i < written; ++i) {
+                    m_stats.send_us.record(std::chrono::duration_cast<std::chrono::microseconds>(write_end - batch[i].enqueued).count());
+                }
+            }
+            // 已写出的命令已经触发了推杆，无论本次写是否成功都不能再发
+            batch.erase(batch.begin(), batch.begin() + (std::ptrdiff_t)written);
+            if (!batch.empty()) {
+                // 端口已由通道关闭；回到循环开头重连后只重发未写出且仍未过期的命令
+                m_connected = false;
+                std::cout << "[Warning] Actuator link " << m_name << " lost after " << written << " of " << bytes.size()
+                          << " byte(s): " << m_transport->lastError() << std::endl;
+                m_transport->close();
+            }
+        }
+    }
+    m_transport->close();
+    m_connected = false;
+}
+
+ActuatorLink::Stats ActuatorLink::stats() const {
+    std::lock_guard<std::mutex> lock(m_stats_mutex);
+    return m_stats;
+}
+
+void ActuatorLink::report() const {
+    const Stats s = stats();
+    std::cout << "[Info] Actuator link " << m_name << ": sent=" << s.sent << " batches=" << s.batches
+              << " dropped_full=" << s.dropped_full << " dropped_stale=" << s.dropped_stale
+              << " write_failures=" << s.write_failures << " reconnects=" << s.reconnects << std::endl;
+    if (s.sent > 0) {
+        std::cout << "[Info] Actuator link " << m_name << ": send_us p50=" << s.send_us.percentile(50)
+                  << " p99=" << s.send_us.percentile(99) << " max=" << s.send_us.max()
+                  << ", write_us p50=" << s.write_us.percentile(50) << " p99=" << s.write_us.percentile(99) << std::endl;
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef ACTUATOR_LINK_H
+#define ACTUATOR_LINK_H
+
+#include "ActuatorTransport.h"
+#include "utils/LatencyHistogram.h"
+#include "utils/RingQueue.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// 异步执行器链路：send() 只把命令放进有界无锁队列，立即返回，调用线程永远不会阻塞在串口上。
+// 专用发送线程把队列中积压的命令合并成一次 write；写失败即关闭端口，按指数退避在后台重连。
+// 断线期间积压超过 Config::ACTUATOR_STALE_MS 的命令在重连后丢弃——迟到的推杆动作会打到后面的果子。
+class ActuatorLink {
+public:
+    struct Stats {
+        uint64_t sent = 0;            // 已写出的命令数
+        uint64_t batches = 0;         // write 调用次数
+        uint64_t dropped_full = 0;    // 队列满被拒绝
+        uint64_t dropped_stale = 0;   // 断线积压过久被丢弃
+        uint64_t write_failures = 0;
+        uint64_t reconnects = 0;
+        LatencyHistogram send_us;     // send() 入队到写出完成（微秒）
+        LatencyHistogram write_us;    // 单次 write 调用耗时（微秒）
+    };
+
+    explicit ActuatorLink(std::unique_ptr<ActuatorTransport> transport);
+    ~ActuatorLink(); // 不再接受命令；队列中剩余的命令按正常的重连 / 过期规则处理完后停止
+    ActuatorLink(const ActuatorLink&) = delete;
+    ActuatorLink& operator=(const ActuatorLink&) = delete;
+
+    // 任意线程调用，不阻塞；队列满时返回 false
+    bool send(char code);
+    bool isConnected() const { return m_connected.load(std::memory_order_relaxed); }
+    std::string name() const { return m_name; }
+
+    Stats stats() const;
+    void report() const;
+
+private:
+    struct Command {
+        char code = 0;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    void run();
+    // 端口未打开时按退避间隔重试，直到成功；链路关闭后重试到 give_up_at 为止（此后待发的命令都已过期）。
+    // 返回端口是否可用
+    bool ensure_open(std::chrono::steady_clock::time_point give_up_at);
+
+    std::unique_ptr<ActuatorTransport> m_transport; // 只在发送线程上使用
+    std::string m_name;
+    MpmcQueue<Command> m_queue;
+    std::atomic<bool> m_connected = {false};
+    bool m_was_connected = false; // 只在发送线程上访问
+
+    std::mutex m_closing_mutex;
+    std::condition_variable m_closing_cv;
+    bool m_closing = false;
+
+    mutable std::mutex m_stats_mutex;
+    Stats m_stats;
+
+    std::thread m_thread;
+};
+
+#endif //ACTUATOR_LINK_H
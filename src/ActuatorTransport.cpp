@@ -0,0 +1,13 @@
+#include "ActuatorTransport.h"
+#include "SerialTransport.h"
+#include "LoopbackTransport.h"
+
+std::unique_ptr<ActuatorTransport> make_actuator_transport(const std::string& port, int baud, int write_timeout_ms) {
+    if (port == "loopback") {
+        return std::make_unique<LoopbackTransport>(LoopbackTransport::Mode::InProcess, baud, write_timeout_ms);
+    }
+    if (port == "pty") {
+        return std::make_unique<LoopbackTransport>(LoopbackTransport::Mode::Pty, baud, write_timeout_ms);
+    }
+    return std::make_unique<SerialTransport>(port, baud, write_timeout_ms);
+}
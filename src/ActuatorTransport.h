@@ -0,0 +1,30 @@
+#ifndef ACTUATOR_TRANSPORT_H
+#define ACTUATOR_TRANSPORT_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// 执行器的字节通道：真实串口（Win32 / POSIX termios）或模拟器。
+// 所有调用只发生在 ActuatorLink 的发送线程上，实现不需要线程安全；
+// write 的阻塞时间由实现自身的写超时限定，失败后由调用方 close 并择机重新 open。
+// 每个字节都是一次推杆动作：write 必须如实报告已写出的字节数，调用方重连后只重发其余部分，不能重复触发。
+class ActuatorTransport {
+public:
+    virtual ~ActuatorTransport() = default;
+    // 打开（或重新打开）端口；失败返回 false，不抛异常
+    virtual bool open() = 0;
+    virtual void close() = 0;
+    virtual bool isOpen() const = 0;
+    // 返回已写出的字节数；小于 size 表示断开、出错或超时，此前的字节已到达端口
+    virtual size_t write(const char* data, size_t size) = 0;
+    virtual std::string name() const = 0;
+    // 最近一次失败的原因，供重连日志使用
+    virtual std::string lastError() const = 0;
+};
+
+// 按端口名创建通道："loopback" 为进程内模拟器，"pty" 为伪终端回环（仅 POSIX），其余视为串口设备名。
+// 只构造对象，不打开端口
+std::unique_ptr<ActuatorTransport> make_actuator_transport(const std::string& port, int baud, int write_timeout_ms);
+
+#endif //ACTUATOR_TRANSPORT_H
@@ -0,0 +1,144 @@
+#include "AssignmentSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+    constexpr double INF = std::numeric_limits<double>::infinity();
+
+    // 统一的代价访问：支持转置视图（行数多于列数时按列求解，避免拷贝），
+    // 有门限时每行附带一个只有自己能用的“未分配”虚拟列，代价为 penalty
+    template<typename T>
+    struct CostView {
+        const T* data;
+        ptrdiff_t row_stride, col_stride;
+        int cols;          // 真实列数
+        double gate;
+        double penalty;
+
+        double operator()(int i, int j) const {
+            if (j >= cols) return j - cols == i ? penalty : INF;
+            const double c = (double)data[i * row_stride + j * col_stride];
+            return c < gate ? c : INF; // NaN 同样被拒绝
+        }
+    };
+}
+
+float* AssignmentSolver::cost_buffer(int rows, int cols) {
+    const size_t n = (size_t)rows * (size_t)cols;
+    if (m_cost.size() < n) m_cost.resize(n);
+    return m_cost.data();
+}
+
+double AssignmentSolver::solve(const float* cost, int rows, int cols, std::vector<int>& assignment, double gate) {
+    return solve_impl(cost, rows, cols, assignment, gate);
+}
+
+double AssignmentSolver::solve(const double* cost, int rows, int cols, std::vector<int>& assignment, double gate) {
+    return solve_impl(cost, rows, cols, assignment, gate);
+}
+
+template<typename T>
+double AssignmentSolver::solve_impl(const T* cost, int rows, int cols, std::vector<int>& assignment, double gate) {
+    assignment.assign(rows, -1);
+    if (rows == 0 || cols == 0) return 0.0;
+
+    // 保证 n_rows <= n_cols：行多于列时转置
+    const bool transposed = rows > cols;
+    const int n_rows = transposed ? cols : rows;
+    const int n_real_cols = transposed ? rows : cols;
+    const bool gated = std::isfinite(gate);
+    const int n_cols = gated ? n_real_cols + n_rows : n_real_cols;
+
+    CostView<T> view{cost, transposed ? 1 : (ptrdiff_t)cols, transposed ? (ptrdiff_t)cols : 1, n_real_cols, gate, 0.0};
+    // 虚拟列代价大于任何可行配对的总代价，保证先最大化配对数
+    if (gated) view.penalty = gate * (n_rows + 1);
+
+    m_u.assign(n_rows, 0.0);
+    m_v.assign(n_cols, 0.0);
+    m_shortest.resize(n_cols);
+    m_path.assign(n_cols, -1);
+    m_col4row.assign(n_rows, -1);
+    m_row4col.assign(n_cols, -1);
+    m_remaining.resize(n_cols);
+    m_scanned_rows.resize(n_rows);
+    m_scanned_cols.resize(n_cols);
+
+    for (int cur_row = 0; cur_row < n_rows; ++cur_row) {
+        double min_val = 0.0;
+        const int sink = augmenting_path(view, cur_row, n_real_cols, n_cols, min_val);
+        if (sink < 0) continue; // 无门限且该行全部为 NaN / INF：保持未分配
+
+        // 更新对偶变量
+        m_u[cur_row] += min_val;
+        for (int i = 0; i < n_rows; ++i) {
+            if (m_scanned_rows[i] && i != cur_row) m_u[i] += min_val - m_shortest[m_col4row[i]];
+        }
+        for (int j = 0; j < n_cols; ++j) {
+            if (m_scanned_cols[j]) m_v[j] -= min_val - m_shortest[j];
+        }
+
+        // 沿最短路增广
+        int j = sink;
+        while (true) {
+            const int i = m_path[j];
+            m_row4col[j] = i;
+            std::swap(m_col4row[i], j);
+            if (i == cur_row) break;
+        }
+    }
+
+    double total = 0.0;
+    for (int r = 0; r < n_rows; ++r) {
+        const int c = m_col4row[r];
+        if (c < 0 || c >= n_real_cols) continue; // 虚拟列 = 未分配
+        total += view(r, c);
+        if (transposed) assignment[c] = r;
+        else assignment[r] = c;
+    }
+    return total;
+}
+
+// 从 cur_row 出发的 Dijkstra：在约化代价上寻找到最近空闲列的最短路，返回该列（找不到返回 -1）。
+// 虚拟列只对所属行可达，因此在该行被扫描时才加入候选集，不必每轮遍历全部 n_rows 个虚拟列
+template<typename Cost>
+int AssignmentSolver::augmenting_path(const Cost& cost, int cur_row, int n_real_cols, int n_cols, double& min_val) {
+    const bool gated = n_cols > n_real_cols;
+    int num_remaining = n_real_cols;
+    for (int it = 0; it < n_real_cols; ++it) m_remaining[it] = n_real_cols - it - 1;
+    std::fill(m_scanned_rows.begin(), m_scanned_rows.end(), 0);
+    std::fill(m_scanned_cols.begin(), m_scanned_cols.begin() + n_cols, 0);
+    std::fill(m_shortest.begin(), m_shortest.begin() + n_cols, INF);
+
+    int sink = -1;
+    int i = cur_row;
+    min_val = 0.0;
+    while (sink == -1) {
+        int index = -1;
+        double lowest = INF;
+        m_scanned_rows[i] = 1;
+        if (gated) m_remaining[num_remaining++] = n_real_cols + i;
+        for (int it = 0; it < num_remaining; ++it) {
+            const int j = m_remaining[it];
+            const double r = min_val + cost(i, j) - m_u[i] - m_v[j];
+            if (r < m_shortest[j]) {
+                m_path[j] = i;
+                m_shortest[j] = r;
+            }
+            // 距离相同时优先选择空闲列，尽早结束搜索
+            if (m_shortest[j] < lowest || (m_shortest[j] == lowest && m_row4col[j] == -1)) {
+                lowest = m_shortest[j];
+                index = it;
+            }
+        }
+        min_val = lowest;
+        if (index < 0 || min_val == INF) return -1;
+
+        const int j = m_remaining[index];
+        if (m_row4col[j] == -1) sink = j;
+        else i = m_row4col[j];
+        m_scanned_cols[j] = 1;
+        m_remaining[index] = m_remaining[--num_remaining];
+    }
+    return sink;
+}
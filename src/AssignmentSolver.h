@@ -0,0 +1,37 @@
+#ifndef ASSIGNMENTSOLVER_H
+#define ASSIGNMENTSOLVER_H
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// 矩形指派问题求解器（Jonker-Volgenant 风格的最短增广路 + 对偶变量）。
+// - 代价矩阵为行主序的扁平 float / double 视图，可直接使用 cost_buffer() 提供的复用缓冲区
+// - 所有工作数组在对象内复用：同一规模或更小规模的调用不再分配内存
+// - 门限：cost >= gate（或 NaN）的配对被禁止；先最大化可行配对数，再在此前提下最小化总代价，
+//   与“门限外代价设为极大值后求解、再丢弃门限外配对”的结果一致
+class AssignmentSolver {
+public:
+    static constexpr double NO_GATE = std::numeric_limits<double>::infinity();
+
+    // 返回 rows * cols 的行主序缓冲区（内容未初始化），在下一次调用前有效
+    float* cost_buffer(int rows, int cols);
+
+    // assignment[i] 为第 i 行分配到的列，未分配为 -1；返回已分配配对的总代价。
+    // 有门限时代价须非负。
+    double solve(const float* cost, int rows, int cols, std::vector<int>& assignment, double gate = NO_GATE);
+    double solve(const double* cost, int rows, int cols, std::vector<int>& assignment, double gate = NO_GATE);
+
+private:
+    template<typename T>
+    double solve_impl(const T* cost, int rows, int cols, std::vector<int>& assignment, double gate);
+    template<typename Cost>
+    int augmenting_path(const Cost& cost, int cur_row, int n_real_cols, int n_cols, double& min_val);
+
+    std::vector<float> m_cost;
+    std::vector<double> m_u, m_v, m_shortest;
+    std::vector<int> m_path, m_col4row, m_row4col, m_remaining;
+    std::vector<char> m_scanned_rows, m_scanned_cols;
+};
+
+#endif //ASSIGNMENTSOLVER_H
@@ -0,0 +1,272 @@
+#include "BatchRunner.h"
+#include "FrameDecoder.h"
+#include "ImageProcessor.h"
+#include "TrackManager.h"
+#include "TrackStatistics.h"
+#include "TrajectoryWriter.h"
+#include "config/RuntimeConfig.h"
+#include "utils/BufferPool.h"
+#include "utils/DataTypes.h"
+#include "utils/TrackTable.h"
+#include "utils/Trace.h"
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+
+namespace fs = std::filesystem;
+
+// 单个数据集的全部状态。ready / next_* / tracking 受 mutex 保护；
+// track_manager / tracks / track_stats / trajectory / result 只由当前持有跟踪权（tracking == true）的线程访问
+struct BatchRunner::Job {
+    Result result;
+    std::unique_ptr<FrameDecoder> decoder;
+    std::string output_dir; // output/<数据集名>，重名的数据集追加 _<序号>
+    int frame_count = 0;
+    TrackManager track_manager;
+    TrackTable tracks{(int)RuntimeConfig::current()->lanes.size()};
+    TrackStatistics::Accumulator track_stats;
+    std::unique_ptr<TrajectoryWriter> trajectory;
+    std::chrono::steady_clock::time_point start;
+
+    std::mutex mutex;
+    std::map<int, std::optional<ConsumerResult>> ready; // 已处理完、等待按序跟踪的帧；nullopt 表示该帧失败
+    int next_to_track = 0;
+    int next_to_submit = 0;
+    bool tracking = false;
+};
+
+BatchRunner::BatchRunner(unsigned int threads) : m_pool(threads) {
+    ImageProcessor::initialize();
+}
+
+BatchRunner::~BatchRunner() = default;
+
+std::vector<BatchRunner::Result> BatchRunner::run(const std::vector<std::string>& input_paths) {
+    std::vector<std::unique_ptr<Job>> jobs;
+    std::set<std::string> output_dirs;
+    for (size_t i = 0; i < input_paths.size(); ++i) {
+        const std::string& path = input_paths[i];
+        auto job = std::make_unique<Job>();
+        job->result.input_path = path;
+        job->track_manager.setVerbose(false);
+        try {
+            // 批处理不显示，录制文件的 ROI 裁剪帧不填充 ROI 外区域
+            job->decoder = std::make_unique<FrameDecoder>(path, false);
+            job->frame_count = (int)job->decoder->size();
+            job->result.codec = job->decoder->codec();
+        } catch (const std::exception& e) {
+            job->result.error = e.what();
+        }
+        if (job->decoder && job->frame_count == 0) {
+            job->result.error = "No frames";
+            job->decoder.reset();
+        }
+        if (!job->decoder) {
+            jobs.push_back(std::move(job));
+            continue;
+        }
+        // 不同目录下的同名数据集（如 a/day1 与 b/day1）各写各的输出目录，互不覆盖
+        job->output_dir = "output/" + job->decoder->name();
+        if (!output_dirs.insert(job->output_dir).second) {
+            job->output_dir += "_" + std::to_string(i);
+            output_dirs.insert(job->output_dir);
+            std::cout << "[Warning] Dataset name '" << job->decoder->name() << "' is used more than once; writing "
+                      << path << " to " << job->output_dir << std::endl;
+        }
+        if (Config::SAVE_TRAJECTORIES) {
+            try {
+                job->trajectory = std::make_unique<TrajectoryWriter>(job->output_dir + "/" + Config::TRAJECTORY_FILENAME);
+            } catch (const std::exception& e) {
+                std::cerr << "[Error] " << e.what() << " (continuing without trajectories)" << std::endl;
+            }
+        }
+        job->result.frames = job->frame_count;
+        jobs.push_back(std::move(job));
+    }
+
+    // 并行度由线程池按帧提供；OpenCV 内部再开线程只会与池争抢核心
+    const int cv_threads = cv::getNumThreads();
+    cv::setNumThreads(1);
+    std::cout << "[Info] Batch: " << jobs.size() << " dataset(s) on " << m_pool.size() << " worker thread(s)" << std::endl;
+
+    const auto wall_begin = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(m_done_mutex);
+        m_remaining = (int)std::count_if(jobs.begin(), jobs.end(), [](const auto& job) { return job->frame_count > 0; });
+    }
+    // 先给每个数据集各提交一帧、再各提交第二帧……使各数据集从一开始就并行推进
+    for (auto& job : jobs) job->start = wall_begin;
+    for (int k = 0; k < Config::BATCH_FRAMES_IN_FLIGHT; ++k) {
+        for (auto& job : jobs) {
+            std::lock_guard<std::mutex> lock(job->mutex);
+            if (job->next_to_submit >= job->frame_count) continue;
+            submit_frame(*job, job->next_to_submit++);
+        }
+    }
+    {
+        std::unique_lock<std::mutex> lock(m_done_mutex);
+        m_done_cv.wait(lock, [this] { return m_remaining == 0; });
+    }
+    m_pool.wait_idle();
+    m_wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_begin).count();
+    cv::setNumThreads(cv_threads);
+
+    std::vector<Result> results;
+    results.reserve(jobs.size());
+    for (auto& job : jobs) results.push_back(std::move(job->result));
+    return results;
+}
+
+void BatchRunner::submit_frame(Job& job, int frame_idx) {
+    m_pool.submit([this, &job, frame_idx] { process_frame(job, frame_idx); });
+}
+
+void BatchRunner::process_frame(Job& job, int frame_idx) {
+    std::optional<ConsumerResult> result;
+    try {
+        cv::Mat img = BufferPool::instance().make();
+        const auto read_begin = std::chrono::steady_clock::now();
+        if (job.decoder->decode(frame_idx, img)) {
+            FrameTimeline timeline;
+            timeline.stamp(FrameTimeline::Captured);
+            Trace::record(Trace::Span::Capture, read_begin, timeline.captured(), frame_idx);
+            result = ImageProcessor::process_frame({frame_idx, img, RuntimeConfig::current(), timeline});
+            // 跟踪只用检测结果；整帧图像与标签图立即归还缓冲池，等待排序的帧不占大块内存
+            result->original_image.release();
+            result->labels.release();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[Warning] " << job.result.input_path << " frame " << frame_idx << ": " << e.what() << std::endl;
+        result.reset();
+    }
+    deliver(job, frame_idx, std::move(result));
+}
+
+// 按帧号顺序跟踪：放入 ready 后，若没有线程持有跟踪权则由本线程接手，
+// 一直处理到下一个尚未到达的帧为止；每跟踪完一帧补交一帧，保持在途帧数不变
+void BatchRunner::deliver(Job& job, int frame_idx, std::optional<ConsumerResult> result) {
+    std::unique_lock<std::mutex> lock(job.mutex);
+    job.ready.emplace(frame_idx, std::move(result));
+    if (job.tracking) return;
+    job.tracking = true;
+
+    const int frames = job.frame_count;
+    while (true) {
+        auto it = job.ready.find(job.next_to_track);
+        if (it == job.ready.end()) break;
+        std::optional<ConsumerResult> next = std::move(it->second);
+        job.ready.erase(it);
+        if (job.next_to_submit < frames) submit_frame(job, job.next_to_submit++);
+        lock.unlock();
+
+        if (next) track(job, *next);
+        else job.result.unreadable++;
+
+        lock.lock();
+        job.next_to_track++;
+    }
+    job.tracking = false;
+    const bool done = job.next_to_track == frames;
+    lock.unlock();
+    if (done) finish(job);
+}
+
+void BatchRunner::track(Job& job, ConsumerResult& result) {
+    const auto track_begin = std::chrono::steady_clock::now();
+    job.track_manager.update(result, job.tracks);
+    job.result.actions += (int)job.track_manager.takeScheduledActions().size();
+
+    const int64_t timestamp_ns = job.decoder->timestamp_ns(result.frame_idx);
+    job.track_stats.update(job.tracks, job.track_manager.retiredTracks(), result.frame_idx, timestamp_ns / 1e9);
+    if (job.trajectory) job.trajectory->append(job.tracks, result.frame_idx, timestamp_ns);
+    Trace::record(Trace::Span::Track, track_begin, std::chrono::steady_clock::now(), result.frame_idx);
+}
+
+void BatchRunner::finish(Job& job) {
+    Result& r = job.result;
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - job.start).count();
+
+    job.track_stats.finish_all();
+    if (job.trajectory) job.trajectory->close();
+    r.tracks = job.track_stats.tracks_seen();
+
+    const std::vector<TrackStatistics::Summary>& summaries = job.track_stats.summaries();
+    r.summaries = (int)summaries.size();
+    const FrameDecoder::Counters decoded = job.decoder->counters();
+    r.decode_ms = decoded.frames ? decoded.decode_ns / 1e6 / decoded.frames : 0.0;
+    r.ok = r.unreadable < r.frames;
+    if (!r.ok) r.error = "No readable frames";
+    if (!summaries.empty()) {
+        TrackStatistics::write_csv(summaries, job.output_dir + "/" + Config::OUTPUT_CSV_FILENAME);
+    }
+    job.trajectory.reset();
+
+    std::cout << "[Info] Batch done: " << r.input_path << " (" << r.frames << " frames, "
+              << std::fixed << std::setprecision(1) << r.frames / std::max(r.seconds, 1e-9) << " fps)"
+              << std::defaultfloat << std::endl;
+
+    std::lock_guard<std::mutex> lock(m_done_mutex);
+    if (--m_remaining == 0) m_done_cv.notify_all();
+}
+
+void BatchRunner::report(const std::vector<Result>& results) const {
+    int total_frames = 0, failed = 0;
+    std::cout << "\n--- Batch Summary ---" << std::endl;
+    std::cout << std::left << std::setw(48) << "Dataset" << std::right
+              << std::setw(8) << "Frames" << std::setw(8) << "Bad" << std::setw(8) << "Tracks"
+              << std::setw(8) << "Summ." << std::setw(9) << "Actions" << std::setw(10) << "Seconds" << std::setw(9) << "FPS"
+              << std::setw(10) << "Codec" << std::setw(10) << "Dec.ms" << std::endl;
+    std::map<std::string, std::pair<int, double>> codecs; // 编解码方式 -> (帧数, 解码总毫秒)
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& r : results) {
+        std::string name = fs::path(r.input_path).filename().string();
+        if (name.empty()) name = r.input_path;
+        if (!r.ok) {
+            failed++;
+            std::cout << std::left << std::setw(48) << name << std::right << "  FAILED: " << r.error << std::endl;
+            continue;
+        }
+        total_frames += r.frames;
+        std::cout << std::left << std::setw(48) << name << std::right
+                  << std::setw(8) << r.frames << std::setw(8) << r.unreadable << std::setw(8) << r.tracks
+                  << std::setw(8) << r.summaries << std::setw(9) << r.actions << std::setw(10) << r.seconds
+                  << std::setw(9) << r.frames / std::max(r.seconds, 1e-9)
+                  << std::setw(10) << r.codec << std::setw(10) << r.decode_ms << std::endl;
+        auto& codec = codecs[r.codec];
+        codec.first += r.frames - r.unreadable;
+        codec.second += r.decode_ms * (r.frames - r.unreadable);
+    }
+    // 单线程解码吞吐按编解码方式汇总，与流水线总吞吐对照即可看出解码是否为瓶颈
+    for (const auto& [name, codec] : codecs) {
+        const double ms = codec.second / std::max(codec.first, 1);
+        std::cout << "[Info] Decode (" << name << "): " << codec.first << " frames, " << ms << " ms/frame, "
+                  << 1000.0 / std::max(ms, 1e-6) << " fps per thread" << std::endl;
+    }
+    const WorkStealingPool::Counters pool = m_pool.counters();
+    std::cout << "[Info] Batch: " << total_frames << " frames from " << results.size() - failed << " dataset(s) in "
+              << m_wall_seconds << " s (" << total_frames / std::max(m_wall_seconds, 1e-9) << " fps aggregate), "
+              << pool.executed << " tasks, " << pool.stolen << " stolen" << std::endl;
+    std::cout << std::defaultfloat;
+
+    const std::string csv_path = "output/" + Config::BATCH_REPORT_FILENAME;
+    std::error_code ec;
+    fs::create_directories("output", ec);
+    std::ofstream csv(csv_path);
+    if (!csv.is_open()) {
+        std::cerr << "[Error] Could not open file for writing: " << csv_path << std::endl;
+        return;
+    }
+    csv << "Dataset,OK,Frames,Unreadable,Tracks,Summarized,Actions,Seconds,FPS,Codec,DecodeMsPerFrame,Error\n";
+    csv << std::fixed << std::setprecision(3);
+    for (const auto& r : results) {
+        csv << r.input_path << "," << (r.ok ? 1 : 0) << "," << r.frames << "," << r.unreadable << ","
+            << r.tracks << "," << r.summaries << "," << r.actions << "," << r.seconds << ","
+            << (r.ok ? r.frames / std::max(r.seconds, 1e-9) : 0.0) << "," << r.codec << "," << r.decode_ms << "," << r.error << "\n";
+    }
+    std::cout << "[Info] Batch report saved to: " << csv_path << std::endl;
+}
@@ -0,0 +1,61 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include "utils/WorkStealingPool.h"
+#include "config/Configuration.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct ConsumerResult;
+
+// 无界面批处理：多个数据集同时运行在同一个工作窃取线程池上。
+// 每帧的读图 + 分割 + 标记是一个独立任务；每个数据集保留自己的 TrackManager，
+// 跟踪按帧号严格有序，由“恰好完成了队首帧”的工作线程顺带执行（每个数据集同一时刻至多一个线程在跟踪），
+// 没有专门的跟踪线程。每跟踪完一帧再提交该数据集的下一帧，在途帧数不超过 BATCH_FRAMES_IN_FLIGHT。
+// 不显示、不录像、不驱动执行器；每个数据集写出与交互模式相同的汇总 CSV 与完整轨迹文件，结束时输出总吞吐报告。
+class BatchRunner {
+public:
+    struct Result {
+        std::string input_path;
+        bool ok = false;
+        std::string error;
+        int frames = 0;       // 目录中的图片数或录制文件的帧数
+        int unreadable = 0;   // 读图或处理失败的帧
+        int tracks = 0;       // 出现过的轨迹数
+        int summaries = 0;    // 写入汇总 CSV 的目标数
+        int actions = 0;      // 排定的执行器动作数
+        double seconds = 0.0; // 首帧提交到末帧跟踪完成
+        std::string codec;    // FrameDecoder::codec()
+        double decode_ms = 0.0; // 每帧平均解码耗时（单线程）
+    };
+
+    explicit BatchRunner(unsigned int threads = Config::BATCH_THREADS);
+    ~BatchRunner();
+
+    // 阻塞直到全部数据集处理完毕；单个数据集失败不影响其他数据集
+    std::vector<Result> run(const std::vector<std::string>& input_paths);
+    // 打印并写出 output/BATCH_REPORT_FILENAME
+    void report(const std::vector<Result>& results) const;
+
+private:
+    struct Job;
+
+    void submit_frame(Job& job, int frame_idx);
+    void process_frame(Job& job, int frame_idx);
+    void deliver(Job& job, int frame_idx, std::optional<ConsumerResult> result);
+    void track(Job& job, ConsumerResult& result);
+    void finish(Job& job);
+
+    WorkStealingPool m_pool;
+    double m_wall_seconds = 0.0;
+
+    std::mutex m_done_mutex;
+    std::condition_variable m_done_cv;
+    int m_remaining = 0;
+};
+
+#endif //BATCH_RUNNER_H
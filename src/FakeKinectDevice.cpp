@@ -0,0 +1,80 @@
+#include "FakeKinectDevice.h"
+#include "config/Configuration.h"
+#include "utils/BufferPool.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+FakeKinectDevice::FakeKinectDevice(const std::string& directory, float fps, bool loop)
+    : m_loop(loop),
+      m_period(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / fps))) {
+    if (RecordingReader::is_recording(directory)) {
+        try {
+            m_recording = std::make_unique<RecordingReader>(directory);
+            m_frame_count = m_recording->size();
+        } catch (const std::exception& e) {
+            std::cerr << "[ERROR] Fake Kinect: " << e.what() << std::endl;
+            return;
+        }
+    } else {
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(directory, ec)) {
+            if (entry.path().extension() == ".png" || entry.path().extension() == ".jpg") {
+                m_files.push_back(entry.path().string());
+            }
+        }
+        std::sort(m_files.begin(), m_files.end());
+        m_frame_count = m_files.size();
+    }
+    if (m_frame_count == 0) {
+        std::cerr << "[ERROR] Fake Kinect: No images found in " << directory << std::endl;
+        return;
+    }
+    std::cout << "[INFO] Fake Kinect replaying " << m_frame_count << " frames from " << directory << std::endl;
+    m_next_frame_time = std::chrono::steady_clock::now();
+    m_is_opened = true;
+}
+
+bool FakeKinectDevice::isOpened() const {
+    return m_is_opened;
+}
+
+bool FakeKinectDevice::getNextFrame(cv::Mat& colorFrame) {
+    if (!m_is_opened) return false;
+    if (m_next >= m_frame_count) {
+        if (!m_loop) {
+            m_is_opened = false;
+            return false;
+        }
+        m_next = 0;
+    }
+
+    // 模拟传感器的固定帧率：来不及取帧时不补发，与真实设备一致
+    std::this_thread::sleep_until(m_next_frame_time);
+    m_next_frame_time = (std::max)(m_next_frame_time + m_period, std::chrono::steady_clock::now());
+
+    const BufferPool& pool = BufferPool::instance();
+    cv::Mat frame = pool.make();
+    if (m_recording) {
+        if (!m_recording->read(m_next, frame)) frame.release();
+        m_recording->prefetch(++m_next);
+    } else {
+        cv::imread(m_files[m_next++], frame, cv::IMREAD_COLOR);
+    }
+    if (frame.empty()) return false;
+    // 录制文件可能保存的是 BGR 或 BGRA，统一转换为 CAPTURE_FORMAT 要求的格式
+    const bool want_bgra = Config::CAPTURE_FORMAT == Config::CaptureFormat::BgraZeroCopy;
+    if (want_bgra && frame.channels() == 3) {
+        colorFrame = pool.make();
+        cv::cvtColor(frame, colorFrame, cv::COLOR_BGR2BGRA);
+    } else if (!want_bgra && frame.channels() == 4) {
+        colorFrame = pool.make();
+        cv::cvtColor(frame, colorFrame, cv::COLOR_BGRA2BGR);
+    } else {
+        colorFrame = frame;
+    }
+    return true;
+}
@@ -0,0 +1,29 @@
+#ifndef FAKE_KINECT_DEVICE_H
+#define FAKE_KINECT_DEVICE_H
+
+#include "FrameSource.h"
+#include "FrameRecording.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 文件回放的模拟 Kinect：按文件名顺序读取目录下的 .png / .jpg（或按索引读取录制文件），以 fps 的节拍出帧，
+// 输出格式与 KinectManager 相同（由 Config::CAPTURE_FORMAT 决定 BGR 或 BGRA）。
+// 帧内存来自 BufferPool，同样在最后一个流水线阶段释放后回收，便于脱离传感器测试实时链路。
+class FakeKinectDevice : public FrameSource {
+public:
+    FakeKinectDevice(const std::string& directory, float fps, bool loop = false);
+    bool isOpened() const override;
+    bool getNextFrame(cv::Mat& colorFrame) override;
+private:
+    std::vector<std::string> m_files;
+    std::unique_ptr<RecordingReader> m_recording;
+    size_t m_frame_count = 0;
+    size_t m_next = 0;
+    bool m_loop;
+    bool m_is_opened = false;
+    std::chrono::steady_clock::duration m_period;
+    std::chrono::steady_clock::time_point m_next_frame_time;
+};
+#endif //FAKE_KINECT_DEVICE_H
@@ -0,0 +1,138 @@
+#include "FrameDecoder.h"
+#include "config/Configuration.h"
+#include "utils/BufferPool.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace {
+    static_assert(Config::LOSSY_JPEG_DECODE_SCALE == 1 || Config::LOSSY_JPEG_DECODE_SCALE == 2 ||
+                  Config::LOSSY_JPEG_DECODE_SCALE == 4 || Config::LOSSY_JPEG_DECODE_SCALE == 8,
+                  "LOSSY_JPEG_DECODE_SCALE must be 1, 2, 4 or 8");
+
+    bool is_jpeg(const std::string& path) {
+        return fs::path(path).extension() == ".jpg";
+    }
+
+    int reduced_flag(int scale) {
+        switch (scale) {
+            case 2: return cv::IMREAD_REDUCED_COLOR_2;
+            case 4: return cv::IMREAD_REDUCED_COLOR_4;
+            case 8: return cv::IMREAD_REDUCED_COLOR_8;
+            default: return cv::IMREAD_COLOR;
+        }
+    }
+}
+
+std::vector<std::string> list_image_files(const std::string& directory) {
+    std::vector<std::string> files;
+    for (const auto& entry : fs::directory_iterator(directory)) {
+        if (entry.path().extension() == ".png" || entry.path().extension() == ".jpg") {
+            files.push_back(entry.path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+FrameDecoder::FrameDecoder(const std::string& input_path, bool fill_outside_roi) : m_fill_outside_roi(fill_outside_roi) {
+    if (RecordingReader::is_recording(input_path)) {
+        m_recording = std::make_unique<RecordingReader>(input_path);
+        m_size = m_recording->size();
+        m_name = fs::path(input_path).stem().string();
+        const char* const payloads[] = {"arec:raw", "arec:roi", "arec:png"};
+        m_codec = m_size ? payloads[m_recording->info(0).payload] : "arec";
+        for (size_t i = 1; i < m_size; ++i) {
+            if (m_recording->info(i).payload != m_recording->info(0).payload) {
+                m_codec = "arec";
+                break;
+            }
+        }
+        if (m_size == 0) throw std::runtime_error("No frames in the recording!");
+    } else {
+        m_files = list_image_files(input_path);
+        m_size = m_files.size();
+        m_name = fs::path(input_path).filename().string();
+        if (m_size == 0) throw std::runtime_error("No images found in the specified directory!");
+        const size_t jpegs = (size_t)std::count_if(m_files.begin(), m_files.end(), is_jpeg);
+        m_codec = jpegs == 0 ? "png" : jpegs == m_size ? "jpg" : "images";
+        if (jpegs > 0 && Config::LOSSY_JPEG_DECODE_SCALE > 1) {
+            m_codec += "/" + std::to_string(Config::LOSSY_JPEG_DECODE_SCALE);
+            std::cout << "[Warning] LOSSY_JPEG_DECODE_SCALE=" << Config::LOSSY_JPEG_DECODE_SCALE << ": JPEG frames in " << m_name
+                      << " are decoded at reduced resolution; detections, tracks and speeds will differ from a full decode." << std::endl;
+        }
+    }
+}
+
+bool FrameDecoder::decode(size_t index, cv::Mat& frame) const {
+    if (index >= m_size) return false;
+    const auto begin = std::chrono::steady_clock::now();
+    bool ok = false;
+    uint64_t bytes = 0;
+    if (m_recording) {
+        ok = m_recording->read(index, frame, m_fill_outside_roi);
+        bytes = m_recording->info(index).payload_size;
+    } else {
+        const std::string& file = m_files[index];
+        std::error_code ec;
+        bytes = (uint64_t)fs::file_size(file, ec);
+        const BufferPool& pool = BufferPool::instance();
+        if (Config::LOSSY_JPEG_DECODE_SCALE > 1 && is_jpeg(file)) {
+            // libjpeg 在 DCT 域直接按 1/N 解码，再放大回原尺寸使 ROI 坐标不变（细节已丢失，下游处理的是低分辨率图像）
+            cv::Mat reduced = pool.make();
+            cv::imread(file, reduced, reduced_flag(Config::LOSSY_JPEG_DECODE_SCALE));
+            frame = pool.make();
+            if (!reduced.empty()) {
+                cv::resize(reduced, frame, {reduced.cols * Config::LOSSY_JPEG_DECODE_SCALE, reduced.rows * Config::LOSSY_JPEG_DECODE_SCALE}, 0, 0, cv::INTER_LINEAR);
+            }
+        } else {
+            // 总是取新缓冲：imread 读取失败时不清空传入的 Mat，调用方复用的旧帧会被当作本帧
+            frame = pool.make();
+            cv::imread(file, frame, cv::IMREAD_COLOR);
+        }
+        ok = !frame.empty();
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+    m_decode_ns.fetch_add((uint64_t)elapsed, std::memory_order_relaxed);
+    m_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    (ok ? m_frames : m_failures).fetch_add(1, std::memory_order_relaxed);
+    return ok;
+}
+
+int64_t FrameDecoder::timestamp_ns(size_t index) const {
+    if (m_recording) return m_recording->timestamp_ns(index);
+    return (int64_t)(index * 1e9 / Config::VIDEO_FPS);
+}
+
+void FrameDecoder::prefetch(size_t index) const {
+    if (m_recording) m_recording->prefetch(index);
+}
+
+FrameDecoder::Counters FrameDecoder::counters() const {
+    Counters c;
+    c.frames = m_frames.load(std::memory_order_relaxed);
+    c.failures = m_failures.load(std::memory_order_relaxed);
+    c.bytes = m_bytes.load(std::memory_order_relaxed);
+    c.decode_ns = m_decode_ns.load(std::memory_order_relaxed);
+    return c;
+}
+
+void FrameDecoder::report(double wall_seconds) const {
+    const Counters c = counters();
+    if (c.frames == 0) return;
+    const double ms_per_frame = c.decode_ns / 1e6 / c.frames;
+    std::cout << "[Info] Decode (" << m_codec << "): frames=" << c.frames
+              << std::fixed << std::setprecision(2)
+              << " mb_per_frame=" << c.bytes / (1024.0 * 1024.0) / (c.frames + c.failures)
+              << " ms_per_frame=" << ms_per_frame
+              << " fps_per_thread=" << std::setprecision(1) << 1000.0 / std::max(ms_per_frame, 1e-6)
+              << " fps_wall=" << c.frames / std::max(wall_seconds, 1e-9)
+              << std::defaultfloat;
+    if (c.failures) std::cout << " failed=" << c.failures;
+    std::cout << std::endl;
+}
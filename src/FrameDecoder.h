@@ -0,0 +1,63 @@
+#ifndef FRAME_DECODER_H
+#define FRAME_DECODER_H
+
+#include "FrameRecording.h"
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 数据集帧来源：图片目录（按文件名排序的 .png / .jpg）或录制文件。decode 为 const 且可多线程并发调用，
+// 数据集模式的 decode 阶段与批处理的线程池都按帧号把解码分散到多个线程，顺序由下游的重排恢复。
+// 能按区域解码的负载只解出车道 ROI：录制文件的 RoiCrop 只拷贝裁剪区域（fill_outside_roi 为 false 时不填充其余像素）；
+// OpenCV 的 PNG / JPEG 解码器不支持按区域解码，整帧解码；LOSSY_JPEG_DECODE_SCALE 非 1 时 JPEG 缩小尺度解码（有损，影响检测结果）。
+// 构造失败（目录不存在、录制文件损坏、没有帧）时抛出 std::runtime_error。
+class FrameDecoder {
+public:
+    struct Counters {
+        uint64_t frames = 0;
+        uint64_t failures = 0;
+        uint64_t bytes = 0;      // 压缩数据字节数（文件大小 / 录制负载）
+        uint64_t decode_ns = 0;  // 各线程解码耗时之和
+    };
+
+    explicit FrameDecoder(const std::string& input_path, bool fill_outside_roi = true);
+
+    size_t size() const { return m_size; }
+    // 数据集名：目录名或去掉扩展名的录制文件名，用于 output/<名>/
+    const std::string& name() const { return m_name; }
+    // 编解码方式：png / jpg / 混合目录为 images；录制文件为 arec:raw / arec:roi / arec:png（多种负载时为 arec）；LOSSY_JPEG_DECODE_SCALE 生效时附加 /N，如 jpg/2
+    const std::string& codec() const { return m_codec; }
+    const RecordingReader* recording() const { return m_recording.get(); }
+
+    // 解码第 index 帧到 frame（池中缓冲区，Raw 录制为零拷贝视图）；失败返回 false
+    bool decode(size_t index, cv::Mat& frame) const;
+    // 第 index 帧的时间：录制文件为录制时间戳，图片目录按 VIDEO_FPS 推算
+    int64_t timestamp_ns(size_t index) const;
+    // 提示预读（仅录制文件）
+    void prefetch(size_t index) const;
+
+    Counters counters() const;
+    // 打印本次解码吞吐：单线程等效 fps 与墙钟 fps
+    void report(double wall_seconds) const;
+
+private:
+    std::vector<std::string> m_files;
+    std::unique_ptr<RecordingReader> m_recording;
+    size_t m_size = 0;
+    std::string m_name;
+    std::string m_codec;
+    bool m_fill_outside_roi;
+
+    mutable std::atomic<uint64_t> m_frames = {0};
+    mutable std::atomic<uint64_t> m_failures = {0};
+    mutable std::atomic<uint64_t> m_bytes = {0};
+    mutable std::atomic<uint64_t> m_decode_ns = {0};
+};
+
+// 目录下按文件名排序的 .png / .jpg 路径
+std::vector<std::string> list_image_files(const std::string& directory);
+
+#endif //FRAME_DECODER_H
@@ -0,0 +1,281 @@
+#include "FrameRecording.h"
+#include "FrameDecoder.h"
+#include "config/RuntimeConfig.h"
+#include "utils/BufferPool.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char FILE_MAGIC[8] = {'A', 'P', 'L', 'R', 'E', 'C', '0', '1'};
+    constexpr uint32_t FILE_VERSION = 1;
+    constexpr uint32_t FRAME_MAGIC = 0x314D5246;  // "FRM1"
+    constexpr uint32_t INDEX_MAGIC = 0x31584449;  // "IDX1"
+    constexpr uint64_t ALIGNMENT = 64;            // 负载按缓存行对齐，零拷贝视图可直接走 SIMD 路径
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t header_size;
+        uint64_t frame_count;
+        uint64_t index_offset; // 0 表示写入未正常结束，需要扫描帧记录
+        uint8_t reserved[32];
+    };
+    static_assert(sizeof(FileHeader) == 64, "FileHeader layout");
+    static_assert(sizeof(RecordingFrameInfo) == 80, "RecordingFrameInfo layout");
+
+    struct IndexHeader {
+        uint32_t magic;
+        uint32_t record_size;
+        uint64_t count;
+    };
+
+    uint64_t align_up(uint64_t offset) {
+        return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    // 帧记录与文件大小、自身尺寸是否一致，防止损坏的文件构造越界视图
+    bool valid(const RecordingFrameInfo& r, size_t file_size) {
+        if (r.magic != FRAME_MAGIC || r.payload > (uint32_t)Config::RecordingPayload::Png) return false;
+        if (r.width <= 0 || r.height <= 0 || r.payload_offset > file_size || r.payload_size > file_size - r.payload_offset) return false;
+        if (r.roi_x < 0 || r.roi_y < 0 || r.roi_w <= 0 || r.roi_h <= 0 || r.roi_x + r.roi_w > r.width || r.roi_y + r.roi_h > r.height) return false;
+        if ((Config::RecordingPayload)r.payload == Config::RecordingPayload::Png) return true;
+        // 整帧记录按完整尺寸构造视图，ROI 必须覆盖整帧，载荷须容纳 height 行
+        if ((Config::RecordingPayload)r.payload == Config::RecordingPayload::Raw &&
+            (r.roi_x != 0 || r.roi_y != 0 || r.roi_w != r.width || r.roi_h != r.height)) return false;
+        const uint64_t row_bytes = (uint64_t)r.roi_w * CV_ELEM_SIZE(r.type);
+        return r.step >= row_bytes && r.step * (uint64_t)(r.roi_h - 1) + row_bytes <= r.payload_size;
+    }
+}
+
+// --- 写入 ---
+
+RecordingWriter::RecordingWriter(const std::string& path, Config::RecordingPayload payload, cv::Rect crop)
+    : m_path(path), m_payload(payload), m_crop(crop) {
+    const fs::path parent = fs::path(path).parent_path();
+    if (!parent.empty()) fs::create_directories(parent);
+    m_out.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_out.is_open()) throw std::runtime_error("Could not open recording for writing: " + path);
+    FileHeader header{};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FILE_VERSION;
+    header.header_size = sizeof(FileHeader);
+    put(&header, sizeof(header));
+}
+
+RecordingWriter::~RecordingWriter() {
+    close();
+}
+
+void RecordingWriter::put(const void* data, size_t size) {
+    m_out.write((const char*)data, (std::streamsize)size);
+    m_offset += size;
+}
+
+void RecordingWriter::pad_to_alignment() {
+    static const char zeros[ALIGNMENT] = {};
+    const uint64_t padding = align_up(m_offset) - m_offset;
+    if (padding) put(zeros, (size_t)padding);
+}
+
+bool RecordingWriter::write(const cv::Mat& frame, int64_t timestamp_ns) {
+    if (m_failed || !m_out.is_open() || frame.empty()) return false;
+
+    cv::Rect region(0, 0, frame.cols, frame.rows);
+    if (m_payload == Config::RecordingPayload::RoiCrop && !m_crop.empty()) {
+        region &= m_crop;
+        if (region.empty()) region = {0, 0, frame.cols, frame.rows};
+    }
+    const cv::Mat view = frame(region);
+
+    RecordingFrameInfo record{};
+    record.magic = FRAME_MAGIC;
+    record.payload = (uint32_t)m_payload;
+    record.type = frame.type();
+    record.width = frame.cols;
+    record.height = frame.rows;
+    record.roi_x = region.x;
+    record.roi_y = region.y;
+    record.roi_w = region.width;
+    record.roi_h = region.height;
+    record.timestamp_ns = timestamp_ns;
+    record.payload_offset = align_up(m_offset + sizeof(record));
+    if (m_payload == Config::RecordingPayload::Png) {
+        if (!cv::imencode(".png", frame, m_encoded, {cv::IMWRITE_PNG_COMPRESSION, Config::RECORDING_PNG_COMPRESSION})) {
+            std::cerr << "[Warning] Could not encode frame for " << m_path << std::endl;
+            return false;
+        }
+        record.payload_size = m_encoded.size();
+    } else {
+        // 行紧密排列：ROI 视图或带填充的帧逐行写出
+        record.step = (uint64_t)view.cols * view.elemSize();
+        record.payload_size = record.step * view.rows;
+    }
+
+    put(&record, sizeof(record));
+    pad_to_alignment();
+    if (m_payload == Config::RecordingPayload::Png) {
+        put(m_encoded.data(), m_encoded.size());
+    } else if (view.isContinuous()) {
+        put(view.data, (size_t)record.payload_size);
+    } else {
+        for (int y = 0; y < view.rows; ++y) put(view.ptr(y), (size_t)record.step);
+    }
+    pad_to_alignment();
+
+    if (!m_out.good()) {
+        std::cerr << "[Error] Write failed, recording stopped: " << m_path << std::endl;
+        m_failed = true;
+        return false;
+    }
+    m_index.push_back(record);
+    return true;
+}
+
+void RecordingWriter::close() {
+    if (!m_out.is_open()) return;
+    const uint64_t index_offset = m_offset;
+    const IndexHeader index{INDEX_MAGIC, (uint32_t)sizeof(RecordingFrameInfo), (uint64_t)m_index.size()};
+    put(&index, sizeof(index));
+    if (!m_index.empty()) put(m_index.data(), m_index.size() * sizeof(RecordingFrameInfo));
+
+    // 索引写完后才回填文件头：中途崩溃的文件 index_offset 仍为 0，读取时改为扫描
+    FileHeader header{};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FILE_VERSION;
+    header.header_size = sizeof(FileHeader);
+    header.frame_count = m_index.size();
+    header.index_offset = m_failed ? 0 : index_offset;
+    m_out.seekp(0);
+    m_out.write((const char*)&header, sizeof(header));
+    m_out.close();
+}
+
+// --- 读取 ---
+
+RecordingReader::RecordingReader(const std::string& path) : m_file(std::make_unique<MappedFile>(path)) {
+    const uint8_t* data = m_file->data();
+    const size_t size = m_file->size();
+    FileHeader header;
+    if (size < sizeof(header)) throw std::runtime_error("Not a recording file: " + path);
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) throw std::runtime_error("Not a recording file: " + path);
+    if (header.version != FILE_VERSION) {
+        throw std::runtime_error("Unsupported recording version " + std::to_string(header.version) + ": " + path);
+    }
+
+    IndexHeader index{};
+    if (header.index_offset >= sizeof(header) && header.index_offset <= size - sizeof(index)) {
+        std::memcpy(&index, data + header.index_offset, sizeof(index));
+    }
+    const uint64_t index_bytes = index.count * sizeof(RecordingFrameInfo);
+    if (index.magic == INDEX_MAGIC && index.record_size == sizeof(RecordingFrameInfo) &&
+        index.count <= size / sizeof(RecordingFrameInfo) && header.index_offset + sizeof(index) + index_bytes <= size) {
+        m_index.resize((size_t)index.count);
+        if (index.count) std::memcpy(m_index.data(), data + header.index_offset + sizeof(index), (size_t)index_bytes);
+    } else {
+        // 没有有效索引（录制中断）：顺序扫描帧记录，丢弃最后一个不完整的帧
+        for (uint64_t offset = sizeof(header); offset + sizeof(RecordingFrameInfo) <= size;) {
+            RecordingFrameInfo record;
+            std::memcpy(&record, data + offset, sizeof(record));
+            if (!valid(record, size) || record.payload_offset < offset + sizeof(record)) break;
+            m_index.push_back(record);
+            offset = align_up(record.payload_offset + record.payload_size);
+        }
+        std::cerr << "[Warning] Recording " << path << " has no index (not closed cleanly); recovered "
+                  << m_index.size() << " frames" << std::endl;
+    }
+    if (std::any_of(m_index.begin(), m_index.end(), [size](const RecordingFrameInfo& r) { return !valid(r, size); })) {
+        throw std::runtime_error("Corrupt frame index in recording: " + path);
+    }
+}
+
+RecordingReader::~RecordingReader() = default;
+
+bool RecordingReader::is_recording(const std::string& path) {
+    std::error_code ec;
+    return fs::path(path).extension() == Config::RECORDING_EXTENSION && fs::is_regular_file(path, ec);
+}
+
+size_t RecordingReader::find_frame(int64_t timestamp_ns) const {
+    auto it = std::lower_bound(m_index.begin(), m_index.end(), timestamp_ns,
+        [](const RecordingFrameInfo& r, int64_t t) { return r.timestamp_ns < t; });
+    return (size_t)(it - m_index.begin());
+}
+
+bool RecordingReader::read(size_t index, cv::Mat& frame, bool fill_outside_roi) const {
+    if (index >= m_index.size()) return false;
+    const RecordingFrameInfo& r = m_index[index];
+    uint8_t* payload = m_file->data() + r.payload_offset;
+    switch ((Config::RecordingPayload)r.payload) {
+        case Config::RecordingPayload::Raw:
+            frame = cv::Mat(r.height, r.width, r.type, payload, (size_t)r.step);
+            return true;
+        case Config::RecordingPayload::RoiCrop: {
+            // 分割只读取各车道 ROI；ROI 外填黑仅供显示，不显示时省去整帧填充
+            frame = BufferPool::instance().acquire({r.width, r.height}, r.type);
+            if (fill_outside_roi) frame.setTo(cv::Scalar::all(0));
+            cv::Mat(r.roi_h, r.roi_w, r.type, payload, (size_t)r.step).copyTo(frame(cv::Rect(r.roi_x, r.roi_y, r.roi_w, r.roi_h)));
+            return true;
+        }
+        case Config::RecordingPayload::Png: {
+            frame = BufferPool::instance().make();
+            cv::imdecode(cv::Mat(1, (int)r.payload_size, CV_8U, payload), cv::IMREAD_UNCHANGED, &frame);
+            return !frame.empty() && frame.cols == r.width && frame.rows == r.height;
+        }
+    }
+    return false;
+}
+
+void RecordingReader::prefetch(size_t index) const {
+    if (index >= m_index.size()) return;
+    m_file->prefetch((size_t)m_index[index].payload_offset, (size_t)m_index[index].payload_size);
+}
+
+std::string RecordingReader::describe() const {
+    size_t counts[3] = {0, 0, 0};
+    for (const auto& r : m_index) counts[r.payload]++;
+    const double seconds = m_index.empty() ? 0.0 : (m_index.back().timestamp_ns - m_index.front().timestamp_ns) / 1e9;
+    std::ostringstream out;
+    out << m_index.size() << " frames, " << seconds << " s (raw=" << counts[0] << " roi=" << counts[1] << " png=" << counts[2] << ")";
+    return out.str();
+}
+
+// --- 转换 ---
+
+size_t convert_image_directory(const std::string& directory, const std::string& output_path,
+                               Config::RecordingPayload payload, float fps) {
+    const std::vector<std::string> files = list_image_files(directory);
+    if (files.empty()) throw std::runtime_error("No images found in the specified directory!");
+
+    RecordingWriter writer(output_path, payload, recording_crop_for_lanes(RuntimeConfig::current()->lanes));
+    const double frame_ns = 1e9 / fps;
+    size_t skipped = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        // 每帧取新缓冲：imread 读取失败时不会清空传入的 Mat，复用会把上一帧当作本帧写入
+        cv::Mat image = BufferPool::instance().make();
+        cv::imread(files[i], image, cv::IMREAD_COLOR);
+        // 读不出的帧不写入，但保留其时间位置，回放时间轴与原目录一致
+        if (image.empty() || !writer.write(image, (int64_t)(i * frame_ns))) {
+            skipped++;
+            continue;
+        }
+        if ((i + 1) % 100 == 0) std::cout << "[Info] Converted " << i + 1 << "/" << files.size() << " frames" << std::endl;
+    }
+    writer.close();
+    std::cout << "[Info] Wrote " << writer.frames() << " frames (" << writer.bytes() / (1024.0 * 1024.0) << " MB) to " << output_path;
+    if (skipped) std::cout << ", skipped " << skipped << " unreadable";
+    std::cout << std::endl;
+    return writer.frames();
+}
+
+cv::Rect recording_crop_for_lanes(const std::vector<Config::Lane>& lanes) {
+    cv::Rect crop;
+    for (const auto& lane : lanes) crop = crop.empty() ? lane.roi : (crop | lane.roi);
+    return crop;
+}
@@ -0,0 +1,99 @@
+#ifndef FRAME_RECORDING_H
+#define FRAME_RECORDING_H
+
+#include "config/Configuration.h"
+#include "utils/MappedFile.h"
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 录制文件格式（小端）：
+//   文件头 64 字节：magic "APLREC01"、版本、帧数、帧索引偏移（0 表示未正常关闭）
+//   逐帧：64 字节对齐的帧记录（尺寸、类型、存储区域、时间戳、负载偏移 / 长度 / 行跨度），其后为 64 字节对齐的负载
+//   帧索引：所有帧记录的副本，关闭时写在文件末尾
+// 帧记录自描述，写入中断（没有索引）的文件可顺序扫描恢复到最后一个完整帧。
+
+// 帧记录：写在每帧负载之前，同时是帧索引的元素
+struct RecordingFrameInfo {
+    uint32_t magic;
+    uint32_t payload;            // Config::RecordingPayload
+    int32_t type;                // cv::Mat 类型
+    int32_t width, height;       // 整帧尺寸
+    int32_t roi_x, roi_y, roi_w, roi_h; // 负载覆盖的区域（Raw / Png 为整帧）
+    uint32_t reserved0;
+    int64_t timestamp_ns;
+    uint64_t payload_offset;
+    uint64_t payload_size;
+    uint64_t step;               // Raw / RoiCrop 负载的行跨度
+    uint64_t reserved1;
+};
+
+// 顺序写入录制文件。write 在调用线程同步写盘，实时模式由专门的录制线程调用。失败时抛出 std::runtime_error。
+class RecordingWriter {
+public:
+    // crop 仅用于 RoiCrop：保存的区域（与帧求交），为空时退化为整帧
+    RecordingWriter(const std::string& path, Config::RecordingPayload payload, cv::Rect crop = {});
+    ~RecordingWriter();
+    RecordingWriter(const RecordingWriter&) = delete;
+    RecordingWriter& operator=(const RecordingWriter&) = delete;
+
+    // timestamp_ns 为相对录制开始的时间；写盘失败返回 false，此后不再写入
+    bool write(const cv::Mat& frame, int64_t timestamp_ns);
+    // 写出帧索引并回填文件头；析构时自动调用
+    void close();
+
+    size_t frames() const { return m_index.size(); }
+    uint64_t bytes() const { return m_offset; }
+
+private:
+    void put(const void* data, size_t size);
+    void pad_to_alignment();
+
+    std::string m_path;
+    Config::RecordingPayload m_payload;
+    cv::Rect m_crop;
+    std::ofstream m_out;
+    uint64_t m_offset = 0;
+    std::vector<RecordingFrameInfo> m_index;
+    std::vector<uchar> m_encoded; // Png 负载的编码缓冲区，跨帧复用
+    bool m_failed = false;
+};
+
+// 通过内存映射随机访问录制文件；read 为 const 且可多线程并发调用。失败时抛出 std::runtime_error。
+class RecordingReader {
+public:
+    explicit RecordingReader(const std::string& path);
+    ~RecordingReader();
+
+    static bool is_recording(const std::string& path);
+
+    size_t size() const { return m_index.size(); }
+    const RecordingFrameInfo& info(size_t index) const { return m_index[index]; }
+    int64_t timestamp_ns(size_t index) const { return m_index[index].timestamp_ns; }
+    // 第一个时间戳不早于 timestamp_ns 的帧（均早于时返回 size()）
+    size_t find_frame(int64_t timestamp_ns) const;
+    // 读取一帧：Raw 负载为指向映射内存的零拷贝视图（本对象析构前有效）；
+    // RoiCrop 为池中整帧缓冲区（ROI 外为黑色；fill_outside_roi 为 false 时不填充，内容未定义）；
+    // Png 解码到池中缓冲区。负载损坏返回 false
+    bool read(size_t index, cv::Mat& frame, bool fill_outside_roi = true) const;
+    // 提示内核预读该帧负载
+    void prefetch(size_t index) const;
+    // 帧数、时长与各类负载的帧数，用于日志
+    std::string describe() const;
+
+private:
+    std::unique_ptr<MappedFile> m_file;
+    std::vector<RecordingFrameInfo> m_index;
+};
+
+// 把图片目录（按文件名排序的 .png / .jpg）转换为录制文件；时间戳按 fps 生成。返回写入的帧数
+size_t convert_image_directory(const std::string& directory, const std::string& output_path,
+                               Config::RecordingPayload payload, float fps);
+
+// 录制文件 ROI 裁剪使用的区域：配置中所有车道 ROI 的外接矩形
+cv::Rect recording_crop_for_lanes(const std::vector<Config::Lane>& lanes);
+
+#endif //FRAME_RECORDING_H
@@ -0,0 +1,17 @@
+#ifndef FRAME_SOURCE_H
+#define FRAME_SOURCE_H
+
+#include <opencv2/opencv.hpp>
+
+// 实时模式的帧来源：真实 Kinect 或文件回放的模拟设备。
+// 输出帧为 CV_8UC3（BGR）或 CV_8UC4（BGRA，取决于 Config::CAPTURE_FORMAT），
+// 帧内存由引用计数管理，最后一个持有它的流水线阶段释放时归还给设备或缓冲池。
+class FrameSource {
+public:
+    virtual ~FrameSource() = default;
+    virtual bool isOpened() const = 0;
+    // 阻塞等待下一帧；超时或暂时无帧返回 false
+    virtual bool getNextFrame(cv::Mat& colorFrame) = 0;
+};
+
+#endif //FRAME_SOURCE_H
@@ -0,0 +1,174 @@
+#include "GatedAssociator.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void GatedAssociator::build_grid(const std::vector<cv::Point2f>& tracks, float cell_size) {
+    m_cell_size = cell_size;
+    m_origin = tracks.front();
+    for (const auto& p : tracks) {
+        m_origin.x = (std::min)(m_origin.x, p.x);
+        m_origin.y = (std::min)(m_origin.y, p.y);
+    }
+    int max_cx = 0, max_cy = 0;
+    for (const auto& p : tracks) {
+        max_cx = (std::max)(max_cx, (int)((p.x - m_origin.x) / m_cell_size));
+        max_cy = (std::max)(max_cy, (int)((p.y - m_origin.y) / m_cell_size));
+    }
+    m_cells_x = (int64_t)max_cx + 1;
+    m_cells_y = max_cy + 1;
+
+    // 只存非空格子：按格子编号排序后，同一行相邻三格的轨迹在数组中连续，一次二分即可取出
+    m_cells.clear();
+    for (int i = 0; i < (int)tracks.size(); ++i) {
+        const int cx = (int)((tracks[i].x - m_origin.x) / m_cell_size);
+        const int cy = (int)((tracks[i].y - m_origin.y) / m_cell_size);
+        m_cells.emplace_back(cell_key(cx, cy), i);
+    }
+    std::sort(m_cells.begin(), m_cells.end());
+}
+
+void GatedAssociator::collect_candidates(const std::vector<cv::Point2f>& tracks, const float* radii, float max_radius,
+                                         const std::vector<cv::Point2f>& detections,
+                                         const std::function<float(int, int)>* cost, float cost_gate) {
+    m_edges.clear();
+    for (int j = 0; j < (int)detections.size(); ++j) {
+        const cv::Point2f& d = detections[j];
+        const int cx = (int)std::floor((d.x - m_origin.x) / m_cell_size);
+        const int cy = (int)std::floor((d.y - m_origin.y) / m_cell_size);
+        const int x_lo = (std::max)(cx - 1, 0);
+        const int x_hi = (int)(std::min)((int64_t)cx + 1, m_cells_x - 1);
+        if (x_lo > x_hi) continue;
+        for (int y = (std::max)(cy - 1, 0); y <= (std::min)(cy + 1, m_cells_y - 1); ++y) {
+            auto it = std::lower_bound(m_cells.begin(), m_cells.end(), std::make_pair(cell_key(x_lo, y), 0));
+            const int64_t last = cell_key(x_hi, y);
+            for (; it != m_cells.end() && it->first <= last; ++it) {
+                const int i = it->second;
+                const cv::Point2f& t = tracks[i];
+                const float dist = std::hypot(t.x - d.x, t.y - d.y);
+                if (dist >= (radii ? radii[i] : max_radius)) continue;
+                const float c = cost ? (*cost)(i, j) : dist;
+                if (c < cost_gate) m_edges.push_back({i, j, c});
+            }
+        }
+    }
+}
+
+int GatedAssociator::find(int x) {
+    while (m_parent[x] != x) {
+        m_parent[x] = m_parent[m_parent[x]];
+        x = m_parent[x];
+    }
+    return x;
+}
+
+void GatedAssociator::unite(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a != b) m_parent[b] = a;
+}
+
+void GatedAssociator::associate(const std::vector<cv::Point2f>& tracks, const std::vector<cv::Point2f>& detections,
+                                float gate, std::vector<int>& assignment) {
+    associate_impl(tracks, nullptr, gate, detections, nullptr, gate, assignment);
+}
+
+void GatedAssociator::associate(const std::vector<cv::Point2f>& tracks, const std::vector<float>& radii,
+                                const std::vector<cv::Point2f>& detections,
+                                const std::function<float(int, int)>& cost, float cost_gate, std::vector<int>& assignment) {
+    CV_Assert(radii.size() == tracks.size());
+    float max_radius = 0.0f;
+    for (float r : radii) max_radius = (std::max)(max_radius, r);
+    associate_impl(tracks, radii.data(), max_radius, detections, &cost, cost_gate, assignment);
+}
+
+void GatedAssociator::associate_impl(const std::vector<cv::Point2f>& tracks, const float* radii, float max_radius,
+                                     const std::vector<cv::Point2f>& detections,
+                                     const std::function<float(int, int)>* cost, float cost_gate, std::vector<int>& assignment) {
+    m_stats = Stats();
+    assignment.assign(tracks.size(), -1);
+    if (tracks.empty() || detections.empty() || !(max_radius > 0)) return;
+    CV_Assert(std::isfinite(max_radius) && cost_gate > 0 && std::isfinite(cost_gate));
+
+    build_grid(tracks, max_radius);
+    collect_candidates(tracks, radii, max_radius, detections, cost, cost_gate);
+    m_stats.candidate_pairs = (int)m_edges.size();
+    if (m_edges.empty()) return;
+
+    // 1. 候选边把轨迹与检测连成若干分量
+    const int n_tracks = (int)tracks.size();
+    const int n_nodes = n_tracks + (int)detections.size();
+    m_parent.resize(n_nodes);
+    for (int n = 0; n < n_nodes; ++n) m_parent[n] = n;
+    for (const Edge& e : m_edges) unite(e.track, n_tracks + e.detection);
+
+    // 2. 为每个分量编号，并给其中的轨迹 / 检测分配局部行号 / 列号
+    m_component.assign(n_nodes, -1);
+    m_local.assign(n_nodes, -1);
+    // rows / cols 先按分量计数（下标 c + 1），再原地转成前缀和
+    std::vector<int>& rows = m_row_start;
+    std::vector<int>& cols = m_col_start;
+    rows.assign(1, 0);
+    cols.assign(1, 0);
+    int n_components = 0;
+    for (const Edge& e : m_edges) {
+        for (int node : {e.track, n_tracks + e.detection}) {
+            if (m_local[node] >= 0) continue;
+            const int root = find(node);
+            if (m_component[root] < 0) {
+                m_component[root] = n_components++;
+                rows.push_back(0);
+                cols.push_back(0);
+            }
+            const int c = m_component[root];
+            m_local[node] = node < n_tracks ? rows[c + 1]++ : cols[c + 1]++;
+        }
+    }
+    for (int c = 0; c < n_components; ++c) {
+        rows[c + 1] += rows[c];
+        cols[c + 1] += cols[c];
+    }
+    m_row_track.resize(rows[n_components]);
+    m_col_detection.resize(cols[n_components]);
+    for (int node = 0; node < n_nodes; ++node) {
+        if (m_local[node] < 0) continue;
+        const int c = m_component[find(node)];
+        if (node < n_tracks) m_row_track[rows[c] + m_local[node]] = node;
+        else m_col_detection[cols[c] + m_local[node]] = node - n_tracks;
+    }
+
+    // 3. 按分量对边做计数排序
+    m_edge_start.assign(n_components + 1, 0);
+    for (const Edge& e : m_edges) m_edge_start[m_component[find(e.track)] + 1]++;
+    for (int c = 0; c < n_components; ++c) m_edge_start[c + 1] += m_edge_start[c];
+    m_sorted_edges.resize(m_edges.size());
+    m_edge_cursor.assign(m_edge_start.begin(), m_edge_start.end() - 1);
+    for (const Edge& e : m_edges) m_sorted_edges[m_edge_cursor[m_component[find(e.track)]]++] = e;
+
+    // 4. 逐分量求解
+    m_stats.components = n_components;
+    constexpr float FORBIDDEN = std::numeric_limits<float>::infinity();
+    for (int c = 0; c < n_components; ++c) {
+        const int n_rows = rows[c + 1] - rows[c];
+        const int n_cols = cols[c + 1] - cols[c];
+        m_stats.largest_component = (std::max)(m_stats.largest_component, n_rows * n_cols);
+        const Edge* edges = &m_sorted_edges[m_edge_start[c]];
+        const int n_edges = m_edge_start[c + 1] - m_edge_start[c];
+        if (n_edges == 1) {
+            // 最常见的情形：孤立的一条轨迹对一个检测
+            assignment[edges[0].track] = edges[0].detection;
+            continue;
+        }
+        float* matrix = m_solver.cost_buffer(n_rows, n_cols);
+        std::fill(matrix, matrix + (size_t)n_rows * n_cols, FORBIDDEN);
+        for (int k = 0; k < n_edges; ++k) {
+            matrix[m_local[edges[k].track] * n_cols + m_local[n_tracks + edges[k].detection]] = edges[k].cost;
+        }
+        m_solver.solve(matrix, n_rows, n_cols, m_local_assignment, cost_gate);
+        for (int r = 0; r < n_rows; ++r) {
+            if (m_local_assignment[r] >= 0) {
+                assignment[m_row_track[rows[c] + r]] = m_col_detection[cols[c] + m_local_assignment[r]];
+            }
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef GATEDASSOCIATOR_H
+#define GATEDASSOCIATOR_H
+
+#include "AssignmentSolver.h"
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// 带空间门限的数据关联：
+//   1. 以门限半径为边长的均匀网格索引轨迹预测位置，每个检测只与相邻 3x3 格内的轨迹比较距离
+//   2. 门限内的候选配对构成二部图，用并查集拆成互不相连的分量
+//   3. 每个分量单独求解（1 对 1 的分量直接配对），结果与整体求解一致
+// 物体密集时代价从 O(T·D) 的稠密矩阵降到接近线性。所有工作区跨帧复用。
+class GatedAssociator {
+public:
+    struct Stats {
+        int candidate_pairs = 0;   // 门限内的候选配对数
+        int components = 0;        // 至少含一条候选边的分量数
+        int largest_component = 0; // 最大分量的矩阵元素数（行 × 列）
+    };
+
+    // assignment[i] 为第 i 条轨迹匹配到的检测下标，未匹配为 -1
+    void associate(const std::vector<cv::Point2f>& tracks, const std::vector<cv::Point2f>& detections,
+                   float gate, std::vector<int>& assignment);
+
+    // 逐轨迹门限（如马氏距离）：第 i 条轨迹只考虑距离小于 radii[i] 的检测，
+    // 候选配对的代价由 cost(i, j) 给出，cost >= cost_gate 的配对被拒绝
+    void associate(const std::vector<cv::Point2f>& tracks, const std::vector<float>& radii,
+                   const std::vector<cv::Point2f>& detections,
+                   const std::function<float(int, int)>& cost, float cost_gate, std::vector<int>& assignment);
+
+    const Stats& last_stats() const { return m_stats; }
+
+private:
+    struct Edge { int track; int detection; float cost; };
+
+    void associate_impl(const std::vector<cv::Point2f>& tracks, const float* radii, float max_radius,
+                        const std::vector<cv::Point2f>& detections,
+                        const std::function<float(int, int)>* cost, float cost_gate, std::vector<int>& assignment);
+    void build_grid(const std::vector<cv::Point2f>& tracks, float cell_size);
+    void collect_candidates(const std::vector<cv::Point2f>& tracks, const float* radii, float max_radius,
+                            const std::vector<cv::Point2f>& detections,
+                            const std::function<float(int, int)>* cost, float cost_gate);
+    int find(int x);
+    void unite(int a, int b);
+
+    int64_t cell_key(int cx, int cy) const { return (int64_t)cy * m_cells_x + cx; }
+
+    // 网格：按格子编号排序的 (key, 轨迹下标)
+    std::vector<std::pair<int64_t, int>> m_cells;
+    cv::Point2f m_origin;
+    float m_cell_size = 1.0f;
+    int64_t m_cells_x = 1;
+    int m_cells_y = 1;
+
+    std::vector<Edge> m_edges;
+    std::vector<int> m_parent;         // 并查集：前 T 个为轨迹，后 D 个为检测
+    std::vector<int> m_component;      // 根节点 -> 分量编号
+    std::vector<int> m_local;          // 节点在所属分量矩阵中的行 / 列号
+    std::vector<int> m_row_start, m_col_start, m_edge_start; // 各分量的行 / 列 / 边在扁平数组中的起点
+    std::vector<int> m_row_track;      // 分量行 -> 轨迹下标
+    std::vector<int> m_col_detection;  // 分量列 -> 检测下标
+    std::vector<int> m_edge_cursor;
+    std::vector<Edge> m_sorted_edges;  // 按分量分桶后的边
+    std::vector<int> m_local_assignment;
+
+    AssignmentSolver m_solver;
+    Stats m_stats;
+};
+
+#endif //GATEDASSOCIATOR_H
@@ -0,0 +1,117 @@
+#include "HsvLookupTable.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <cstring>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr size_t TABLE_BITS = size_t(1) << 24;
+    constexpr size_t TABLE_WORDS = TABLE_BITS / 64;
+    constexpr char CACHE_MAGIC[8] = {'H', 'S', 'V', 'L', 'U', 'T', '0', '1'};
+}
+
+HsvLookupTable::HsvLookupTable(const HsvRangeKernel::Bounds& bounds) : m_bounds(bounds) {
+    build();
+}
+
+HsvLookupTable HsvLookupTable::load_or_build(const HsvRangeKernel::Bounds& bounds, const std::string& cache_dir) {
+    HsvLookupTable table;
+    table.m_bounds = bounds;
+    const std::string path = (fs::path(cache_dir) / cache_file_name(bounds)).string();
+    if (table.load(path)) {
+        std::cout << "[INFO] HSV lookup table loaded from cache: " << path << std::endl;
+        return table;
+    }
+    table.build();
+    if (table.save(path)) {
+        std::cout << "[INFO] HSV lookup table built and cached to: " << path << std::endl;
+    } else {
+        std::cerr << "[Warning] Could not write HSV lookup table cache: " << path << std::endl;
+    }
+    return table;
+}
+
+void HsvLookupTable::build() {
+    m_bits.assign(TABLE_WORDS, 0);
+    // 每次处理同一 (r, g) 下的 256 个 b 值，直接复用融合核
+    uint8_t bgr[256 * 3];
+    uint8_t mask[256];
+    for (int b = 0; b < 256; ++b) bgr[3 * b] = (uint8_t)b;
+    for (int r = 0; r < 256; ++r) {
+        for (int g = 0; g < 256; ++g) {
+            for (int b = 0; b < 256; ++b) {
+                bgr[3 * b + 1] = (uint8_t)g;
+                bgr[3 * b + 2] = (uint8_t)r;
+            }
+            HsvRangeKernel::threshold_row(bgr, mask, 256, m_bounds);
+            uint64_t* words = &m_bits[((size_t)r << 10) | ((size_t)g << 2)];
+            for (int b = 0; b < 256; ++b) {
+                if (mask[b]) words[b >> 6] |= uint64_t(1) << (b & 63);
+            }
+        }
+    }
+}
+
+void HsvLookupTable::threshold(const cv::Mat& image, cv::Mat& mask) const {
+    CV_Assert(image.type() == CV_8UC3 || image.type() == CV_8UC4);
+    mask.create(image.size(), CV_8UC1);
+    const uint64_t* bits = m_bits.data();
+    const int cn = image.channels();
+    for (int y = 0; y < image.rows; ++y) {
+        const uint8_t* src = image.ptr<uint8_t>(y);
+        uint8_t* dst = mask.ptr<uint8_t>(y);
+        for (int x = 0; x < image.cols; ++x, src += cn) {
+            const uint32_t idx = ((uint32_t)src[2] << 16) | ((uint32_t)src[1] << 8) | src[0];
+            dst[x] = (uint8_t)(0 - ((bits[idx >> 6] >> (idx & 63)) & 1));
+        }
+    }
+}
+
+std::string HsvLookupTable::cache_file_name(const HsvRangeKernel::Bounds& bounds) {
+    std::ostringstream name;
+    name << "hsv_lut";
+    for (int c = 0; c < 3; ++c) name << "_" << bounds.lower[c];
+    for (int c = 0; c < 3; ++c) name << "_" << bounds.upper[c];
+    name << ".bin";
+    return name.str();
+}
+
+bool HsvLookupTable::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    char magic[sizeof(CACHE_MAGIC)];
+    HsvRangeKernel::Bounds stored{};
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&stored), sizeof(stored));
+    if (!file || std::memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 ||
+        std::memcmp(&stored, &m_bounds, sizeof(stored)) != 0) {
+        return false;
+    }
+    m_bits.resize(TABLE_WORDS);
+    file.read(reinterpret_cast<char*>(m_bits.data()), TABLE_WORDS * sizeof(uint64_t));
+    if (!file) {
+        m_bits.clear();
+        return false;
+    }
+    return true;
+}
+
+bool HsvLookupTable::save(const std::string& path) const {
+    std::error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+    // 先写临时文件再改名，避免其他进程读到写了一半的缓存
+    const std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        file.write(reinterpret_cast<const char*>(&m_bounds), sizeof(m_bounds));
+        file.write(reinterpret_cast<const char*>(m_bits.data()), TABLE_WORDS * sizeof(uint64_t));
+        if (!file) return false;
+    }
+    fs::rename(tmp_path, path, ec);
+    return !ec;
+}
@@ -0,0 +1,40 @@
+#ifndef HSVLOOKUPTABLE_H
+#define HSVLOOKUPTABLE_H
+
+#include "HsvRangeKernel.h"
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 固定 HSV 阈值下的 BGR -> 掩码查找表：2^24 个 BGR 组合各占 1 位（共 2 MB）。
+// 表由融合核逐位计算生成，因此与 cvtColor + inRange 结果一致；每个像素分类只需一次查表。
+class HsvLookupTable {
+public:
+    explicit HsvLookupTable(const HsvRangeKernel::Bounds& bounds);
+
+    // 优先从 cache_dir 读取与阈值匹配的缓存文件，缺失或损坏时重新生成并写回
+    static HsvLookupTable load_or_build(const HsvRangeKernel::Bounds& bounds, const std::string& cache_dir);
+
+    bool contains(uint8_t b, uint8_t g, uint8_t r) const {
+        const uint32_t idx = ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+        return (m_bits[idx >> 6] >> (idx & 63)) & 1;
+    }
+
+    // 处理整幅图像或 ROI 视图（CV_8UC3 / CV_8UC4），输出 CV_8UC1 掩码（0 或 255）
+    void threshold(const cv::Mat& image, cv::Mat& mask) const;
+
+    const HsvRangeKernel::Bounds& bounds() const { return m_bounds; }
+
+private:
+    HsvLookupTable() = default;
+    void build();
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+    static std::string cache_file_name(const HsvRangeKernel::Bounds& bounds);
+
+    HsvRangeKernel::Bounds m_bounds{};
+    std::vector<uint64_t> m_bits;
+};
+
+#endif //HSVLOOKUPTABLE_H
@@ -0,0 +1,384 @@
+#include "HsvRangeKernel.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define HSV_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define HSV_KERNEL_NEON 1
+#include <arm_neon.h>
+#endif
+
+// GCC/Clang 需要为使用高阶指令集的函数单独标注 target，MSVC 则可直接使用内建函数
+#if defined(HSV_KERNEL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define HSV_TARGET(isa) __attribute__((target(isa)))
+#else
+#define HSV_TARGET(isa)
+#endif
+
+namespace HsvRangeKernel {
+
+    // 与 OpenCV RGB2HSV_b 完全相同的定点参数：
+    //   sdiv[v]    = round((255 << 12) / v)
+    //   hdiv[diff] = round((180 << 12) / (6 * diff)) = round(122880 / diff)
+    // 两个商都不可能恰好落在 .5 上，因此 SIMD 中用“浮点试商 + 余数校正”即可精确复现查表结果。
+    constexpr int HSV_SHIFT = 12;
+    constexpr int HSV_ROUND = 1 << (HSV_SHIFT - 1);
+    constexpr int SDIV_NUMERATOR = 255 << HSV_SHIFT;
+    constexpr int HDIV_NUMERATOR = (180 << HSV_SHIFT) / 6;
+    constexpr int HUE_RANGE = 180;
+
+    namespace {
+
+        struct DivTables {
+            int sdiv[256];
+            int hdiv[256];
+            DivTables() {
+                sdiv[0] = hdiv[0] = 0;
+                for (int i = 1; i < 256; ++i) {
+                    sdiv[i] = cvRound(SDIV_NUMERATOR / (1. * i));
+                    hdiv[i] = cvRound((HUE_RANGE << HSV_SHIFT) / (6. * i));
+                }
+            }
+        };
+
+        const DivTables& div_tables() {
+            static const DivTables tables;
+            return tables;
+        }
+
+        inline bool in_bounds(int h, int s, int v, const Bounds& b) {
+            return h >= b.lower[0] && h <= b.upper[0] &&
+                   s >= b.lower[1] && s <= b.upper[1] &&
+                   v >= b.lower[2] && v <= b.upper[2];
+        }
+
+        void threshold_row_scalar(const uint8_t* src, uint8_t* mask, int x, int width, int cn, const Bounds& bounds) {
+            const DivTables& t = div_tables();
+            for (; x < width; ++x) {
+                const int b = src[cn * x], g = src[cn * x + 1], r = src[cn * x + 2];
+                const int v = std::max(b, std::max(g, r));
+                const int diff = v - std::min(b, std::min(g, r));
+                const int s = (diff * t.sdiv[v] + HSV_ROUND) >> HSV_SHIFT;
+                int h = v == r ? g - b : (v == g ? b - r + 2 * diff : r - g + 4 * diff);
+                h = (h * t.hdiv[diff] + HSV_ROUND) >> HSV_SHIFT;
+                if (h < 0) h += HUE_RANGE;
+                mask[x] = in_bounds(h, s, v, bounds) ? 255 : 0;
+            }
+        }
+
+#if defined(HSV_KERNEL_X86)
+        // 48 字节交错 BGR -> 16 字节 B / G / R
+        HSV_TARGET("ssse3")
+        inline void deinterleave_bgr16(const uint8_t* p, __m128i& b, __m128i& g, __m128i& r) {
+            const __m128i a0 = _mm_loadu_si128((const __m128i*)p);
+            const __m128i a1 = _mm_loadu_si128((const __m128i*)(p + 16));
+            const __m128i a2 = _mm_loadu_si128((const __m128i*)(p + 32));
+            const __m128i b0 = _mm_setr_epi8(0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+            const __m128i b1 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1);
+            const __m128i b2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13);
+            const __m128i g0 = _mm_setr_epi8(1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+            const __m128i g1 = _mm_setr_epi8(-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1);
+            const __m128i g2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14);
+            const __m128i r0 = _mm_setr_epi8(2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+            const __m128i r1 = _mm_setr_epi8(-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1);
+            const __m128i r2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15);
+            b = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a0, b0), _mm_shuffle_epi8(a1, b1)), _mm_shuffle_epi8(a2, b2));
+            g = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a0, g0), _mm_shuffle_epi8(a1, g1)), _mm_shuffle_epi8(a2, g2));
+            r = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a0, r0), _mm_shuffle_epi8(a1, r1)), _mm_shuffle_epi8(a2, r2));
+        }
+
+        // 64 字节交错 BGRA -> 16 字节 B / G / R（丢弃 A）
+        HSV_TARGET("ssse3")
+        inline void deinterleave_bgra16(const uint8_t* p, __m128i& b, __m128i& g, __m128i& r) {
+            // 每 4 个像素先按通道聚拢成 [B4 G4 R4 A4]，再做 4x4 的 32 位转置
+            const __m128i split = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+            const __m128i s0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)p), split);
+            const __m128i s1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(p + 16)), split);
+            const __m128i s2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(p + 32)), split);
+            const __m128i s3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(p + 48)), split);
+            const __m128i bg01 = _mm_unpacklo_epi32(s0, s1);
+            const __m128i ra01 = _mm_unpackhi_epi32(s0, s1);
+            const __m128i bg23 = _mm_unpacklo_epi32(s2, s3);
+            const __m128i ra23 = _mm_unpackhi_epi32(s2, s3);
+            b = _mm_unpacklo_epi64(bg01, bg23);
+            g = _mm_unpackhi_epi64(bg01, bg23);
+            r = _mm_unpacklo_epi64(ra01, ra23);
+        }
+
+        template<int CN>
+        HSV_TARGET("ssse3")
+        inline void deinterleave16(const uint8_t* p, __m128i& b, __m128i& g, __m128i& r) {
+            if constexpr (CN == 4) deinterleave_bgra16(p, b, g, r);
+            else deinterleave_bgr16(p, b, g, r);
+        }
+
+        // round(n / d)，d == 0 时为 0
+        HSV_TARGET("sse4.1")
+        inline __m128i round_div_sse(int n, __m128i d) {
+            const __m128i vn = _mm_set1_epi32(n);
+            __m128i q = _mm_cvttps_epi32(_mm_div_ps(_mm_set1_ps((float)n), _mm_cvtepi32_ps(d)));
+            __m128i rem = _mm_sub_epi32(vn, _mm_mullo_epi32(q, d));
+            const __m128i neg = _mm_cmplt_epi32(rem, _mm_setzero_si128());
+            q = _mm_add_epi32(q, neg);
+            rem = _mm_add_epi32(rem, _mm_and_si128(neg, d));
+            const __m128i over = _mm_cmpgt_epi32(rem, _mm_sub_epi32(d, _mm_set1_epi32(1)));
+            q = _mm_sub_epi32(q, over);
+            rem = _mm_sub_epi32(rem, _mm_and_si128(over, d));
+            // 2 * rem >= d 时进位
+            q = _mm_sub_epi32(q, _mm_cmpgt_epi32(_mm_add_epi32(rem, rem), _mm_sub_epi32(d, _mm_set1_epi32(1))));
+            return _mm_andnot_si128(_mm_cmpeq_epi32(d, _mm_setzero_si128()), q);
+        }
+
+        // 4 个像素（int32 通道）的阈值判定，返回 -1 / 0 掩码
+        HSV_TARGET("sse4.1")
+        inline __m128i classify_sse(__m128i b, __m128i g, __m128i r, const __m128i* lo, const __m128i* hi) {
+            const __m128i v = _mm_max_epi32(_mm_max_epi32(b, g), r);
+            const __m128i diff = _mm_sub_epi32(v, _mm_min_epi32(_mm_min_epi32(b, g), r));
+            const __m128i vr = _mm_cmpeq_epi32(v, r);
+            const __m128i vg = _mm_cmpeq_epi32(v, g);
+            const __m128i h_b = _mm_add_epi32(_mm_sub_epi32(r, g), _mm_slli_epi32(diff, 2));
+            const __m128i h_g = _mm_add_epi32(_mm_sub_epi32(b, r), _mm_slli_epi32(diff, 1));
+            const __m128i h_r = _mm_sub_epi32(g, b);
+            __m128i h = _mm_blendv_epi8(_mm_blendv_epi8(h_b, h_g, vg), h_r, vr);
+
+            const __m128i round = _mm_set1_epi32(HSV_ROUND);
+            const __m128i s = _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(diff, round_div_sse(SDIV_NUMERATOR, v)), round), HSV_SHIFT);
+            h = _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(h, round_div_sse(HDIV_NUMERATOR, diff)), round), HSV_SHIFT);
+            h = _mm_add_epi32(h, _mm_and_si128(_mm_cmplt_epi32(h, _mm_setzero_si128()), _mm_set1_epi32(HUE_RANGE)));
+
+            // lo / hi 已预先减一 / 加一，把闭区间比较化为严格比较
+            __m128i ok = _mm_and_si128(_mm_cmpgt_epi32(h, lo[0]), _mm_cmplt_epi32(h, hi[0]));
+            ok = _mm_and_si128(ok, _mm_and_si128(_mm_cmpgt_epi32(s, lo[1]), _mm_cmplt_epi32(s, hi[1])));
+            return _mm_and_si128(ok, _mm_and_si128(_mm_cmpgt_epi32(v, lo[2]), _mm_cmplt_epi32(v, hi[2])));
+        }
+
+        template<int CN>
+        HSV_TARGET("sse4.1")
+        int threshold_row_sse41(const uint8_t* src, uint8_t* mask, int width, const Bounds& bounds) {
+            __m128i lo[3], hi[3];
+            for (int c = 0; c < 3; ++c) {
+                lo[c] = _mm_set1_epi32(bounds.lower[c] - 1);
+                hi[c] = _mm_set1_epi32(bounds.upper[c] + 1);
+            }
+            int x = 0;
+            for (; x + 16 <= width; x += 16) {
+                __m128i b8, g8, r8;
+                deinterleave16<CN>(src + CN * x, b8, g8, r8);
+                __m128i m[4];
+                for (int k = 0; k < 4; ++k) {
+                    m[k] = classify_sse(_mm_cvtepu8_epi32(b8), _mm_cvtepu8_epi32(g8), _mm_cvtepu8_epi32(r8), lo, hi);
+                    b8 = _mm_srli_si128(b8, 4);
+                    g8 = _mm_srli_si128(g8, 4);
+                    r8 = _mm_srli_si128(r8, 4);
+                }
+                const __m128i packed = _mm_packs_epi16(_mm_packs_epi32(m[0], m[1]), _mm_packs_epi32(m[2], m[3]));
+                _mm_storeu_si128((__m128i*)(mask + x), packed);
+            }
+            return x;
+        }
+
+        HSV_TARGET("avx2")
+        inline __m256i round_div_avx2(int n, __m256i d) {
+            const __m256i vn = _mm256_set1_epi32(n);
+            const __m256i one = _mm256_set1_epi32(1);
+            __m256i q = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_set1_ps((float)n), _mm256_cvtepi32_ps(d)));
+            __m256i rem = _mm256_sub_epi32(vn, _mm256_mullo_epi32(q, d));
+            const __m256i neg = _mm256_cmpgt_epi32(_mm256_setzero_si256(), rem);
+            q = _mm256_add_epi32(q, neg);
+            rem = _mm256_add_epi32(rem, _mm256_and_si256(neg, d));
+            const __m256i over = _mm256_cmpgt_epi32(rem, _mm256_sub_epi32(d, one));
+            q = _mm256_sub_epi32(q, over);
+            rem = _mm256_sub_epi32(rem, _mm256_and_si256(over, d));
+            q = _mm256_sub_epi32(q, _mm256_cmpgt_epi32(_mm256_add_epi32(rem, rem), _mm256_sub_epi32(d, one)));
+            return _mm256_andnot_si256(_mm256_cmpeq_epi32(d, _mm256_setzero_si256()), q);
+        }
+
+        HSV_TARGET("avx2")
+        inline __m256i classify_avx2(__m256i b, __m256i g, __m256i r, const __m256i* lo, const __m256i* hi) {
+            const __m256i v = _mm256_max_epi32(_mm256_max_epi32(b, g), r);
+            const __m256i diff = _mm256_sub_epi32(v, _mm256_min_epi32(_mm256_min_epi32(b, g), r));
+            const __m256i vr = _mm256_cmpeq_epi32(v, r);
+            const __m256i vg = _mm256_cmpeq_epi32(v, g);
+            const __m256i h_b = _mm256_add_epi32(_mm256_sub_epi32(r, g), _mm256_slli_epi32(diff, 2));
+            const __m256i h_g = _mm256_add_epi32(_mm256_sub_epi32(b, r), _mm256_slli_epi32(diff, 1));
+            const __m256i h_r = _mm256_sub_epi32(g, b);
+            __m256i h = _mm256_blendv_epi8(_mm256_blendv_epi8(h_b, h_g, vg), h_r, vr);
+
+            const __m256i round = _mm256_set1_epi32(HSV_ROUND);
+            const __m256i s = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(diff, round_div_avx2(SDIV_NUMERATOR, v)), round), HSV_SHIFT);
+            h = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(h, round_div_avx2(HDIV_NUMERATOR, diff)), round), HSV_SHIFT);
+            h = _mm256_add_epi32(h, _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_setzero_si256(), h), _mm256_set1_epi32(HUE_RANGE)));
+
+            __m256i ok = _mm256_and_si256(_mm256_cmpgt_epi32(h, lo[0]), _mm256_cmpgt_epi32(hi[0], h));
+            ok = _mm256_and_si256(ok, _mm256_and_si256(_mm256_cmpgt_epi32(s, lo[1]), _mm256_cmpgt_epi32(hi[1], s)));
+            return _mm256_and_si256(ok, _mm256_and_si256(_mm256_cmpgt_epi32(v, lo[2]), _mm256_cmpgt_epi32(hi[2], v)));
+        }
+
+        template<int CN>
+        HSV_TARGET("avx2")
+        int threshold_row_avx2(const uint8_t* src, uint8_t* mask, int width, const Bounds& bounds) {
+            __m256i lo[3], hi[3];
+            for (int c = 0; c < 3; ++c) {
+                lo[c] = _mm256_set1_epi32(bounds.lower[c] - 1);
+                hi[c] = _mm256_set1_epi32(bounds.upper[c] + 1);
+            }
+            int x = 0;
+            for (; x + 16 <= width; x += 16) {
+                __m128i b8, g8, r8;
+                deinterleave16<CN>(src + CN * x, b8, g8, r8);
+                const __m256i m0 = classify_avx2(_mm256_cvtepu8_epi32(b8), _mm256_cvtepu8_epi32(g8), _mm256_cvtepu8_epi32(r8), lo, hi);
+                const __m256i m1 = classify_avx2(_mm256_cvtepu8_epi32(_mm_srli_si128(b8, 8)),
+                                                 _mm256_cvtepu8_epi32(_mm_srli_si128(g8, 8)),
+                                                 _mm256_cvtepu8_epi32(_mm_srli_si128(r8, 8)), lo, hi);
+                // packs 按 128 位分道进行，需要重排回像素顺序
+                const __m256i p16 = _mm256_permute4x64_epi64(_mm256_packs_epi32(m0, m1), _MM_SHUFFLE(3, 1, 2, 0));
+                const __m128i packed = _mm_packs_epi16(_mm256_castsi256_si128(p16), _mm256_extracti128_si256(p16, 1));
+                _mm_storeu_si128((__m128i*)(mask + x), packed);
+            }
+            return x;
+        }
+#endif
+
+#if defined(HSV_KERNEL_NEON)
+        inline int32x4_t round_div_neon(int n, int32x4_t d) {
+            const int32x4_t vn = vdupq_n_s32(n);
+            const int32x4_t one = vdupq_n_s32(1);
+            int32x4_t q = vcvtq_s32_f32(vdivq_f32(vdupq_n_f32((float)n), vcvtq_f32_s32(d)));
+            int32x4_t rem = vsubq_s32(vn, vmulq_s32(q, d));
+            const int32x4_t neg = vreinterpretq_s32_u32(vcltq_s32(rem, vdupq_n_s32(0)));
+            q = vaddq_s32(q, neg);
+            rem = vaddq_s32(rem, vandq_s32(neg, d));
+            const int32x4_t over = vreinterpretq_s32_u32(vcgeq_s32(rem, d));
+            q = vsubq_s32(q, over);
+            rem = vsubq_s32(rem, vandq_s32(over, d));
+            q = vsubq_s32(q, vreinterpretq_s32_u32(vcgtq_s32(vaddq_s32(rem, rem), vsubq_s32(d, one))));
+            return vbicq_s32(q, vreinterpretq_s32_u32(vceqq_s32(d, vdupq_n_s32(0))));
+        }
+
+        inline uint32x4_t classify_neon(int32x4_t b, int32x4_t g, int32x4_t r, const int32x4_t* lo, const int32x4_t* hi) {
+            const int32x4_t v = vmaxq_s32(vmaxq_s32(b, g), r);
+            const int32x4_t diff = vsubq_s32(v, vminq_s32(vminq_s32(b, g), r));
+            const uint32x4_t vr = vceqq_s32(v, r);
+            const uint32x4_t vg = vceqq_s32(v, g);
+            const int32x4_t h_b = vaddq_s32(vsubq_s32(r, g), vshlq_n_s32(diff, 2));
+            const int32x4_t h_g = vaddq_s32(vsubq_s32(b, r), vshlq_n_s32(diff, 1));
+            const int32x4_t h_r = vsubq_s32(g, b);
+            int32x4_t h = vbslq_s32(vr, h_r, vbslq_s32(vg, h_g, h_b));
+
+            const int32x4_t round = vdupq_n_s32(HSV_ROUND);
+            const int32x4_t s = vshrq_n_s32(vaddq_s32(vmulq_s32(diff, round_div_neon(SDIV_NUMERATOR, v)), round), HSV_SHIFT);
+            h = vshrq_n_s32(vaddq_s32(vmulq_s32(h, round_div_neon(HDIV_NUMERATOR, diff)), round), HSV_SHIFT);
+            h = vaddq_s32(h, vandq_s32(vreinterpretq_s32_u32(vcltq_s32(h, vdupq_n_s32(0))), vdupq_n_s32(HUE_RANGE)));
+
+            uint32x4_t ok = vandq_u32(vcgeq_s32(h, lo[0]), vcleq_s32(h, hi[0]));
+            ok = vandq_u32(ok, vandq_u32(vcgeq_s32(s, lo[1]), vcleq_s32(s, hi[1])));
+            return vandq_u32(ok, vandq_u32(vcgeq_s32(v, lo[2]), vcleq_s32(v, hi[2])));
+        }
+
+        template<int CN>
+        int threshold_row_neon(const uint8_t* src, uint8_t* mask, int width, const Bounds& bounds) {
+            int32x4_t lo[3], hi[3];
+            for (int c = 0; c < 3; ++c) {
+                lo[c] = vdupq_n_s32(bounds.lower[c]);
+                hi[c] = vdupq_n_s32(bounds.upper[c]);
+            }
+            int x = 0;
+            for (; x + 16 <= width; x += 16) {
+                uint8x16x3_t bgr;
+                if constexpr (CN == 4) {
+                    const uint8x16x4_t bgra = vld4q_u8(src + 4 * x);
+                    bgr = {{bgra.val[0], bgra.val[1], bgra.val[2]}};
+                } else {
+                    bgr = vld3q_u8(src + 3 * x);
+                }
+                const uint16x8_t b16[2] = {vmovl_u8(vget_low_u8(bgr.val[0])), vmovl_u8(vget_high_u8(bgr.val[0]))};
+                const uint16x8_t g16[2] = {vmovl_u8(vget_low_u8(bgr.val[1])), vmovl_u8(vget_high_u8(bgr.val[1]))};
+                const uint16x8_t r16[2] = {vmovl_u8(vget_low_u8(bgr.val[2])), vmovl_u8(vget_high_u8(bgr.val[2]))};
+                uint16x4_t m16[4];
+                for (int k = 0; k < 4; ++k) {
+                    const int half = k >> 1;
+                    const bool high = k & 1;
+                    const int32x4_t b = vreinterpretq_s32_u32(vmovl_u16(high ? vget_high_u16(b16[half]) : vget_low_u16(b16[half])));
+                    const int32x4_t g = vreinterpretq_s32_u32(vmovl_u16(high ? vget_high_u16(g16[half]) : vget_low_u16(g16[half])));
+                    const int32x4_t r = vreinterpretq_s32_u32(vmovl_u16(high ? vget_high_u16(r16[half]) : vget_low_u16(r16[half])));
+                    m16[k] = vmovn_u32(classify_neon(b, g, r, lo, hi));
+                }
+                const uint8x8_t lo8 = vmovn_u16(vcombine_u16(m16[0], m16[1]));
+                const uint8x8_t hi8 = vmovn_u16(vcombine_u16(m16[2], m16[3]));
+                vst1q_u8(mask + x, vcombine_u8(lo8, hi8));
+            }
+            return x;
+        }
+#endif
+
+        enum class Isa { Scalar, Sse41, Avx2, Neon };
+
+        Isa detect_isa() {
+#if defined(HSV_KERNEL_X86)
+            if (cv::checkHardwareSupport(CV_CPU_AVX2)) return Isa::Avx2;
+            if (cv::checkHardwareSupport(CV_CPU_SSE4_1) && cv::checkHardwareSupport(CV_CPU_SSSE3)) return Isa::Sse41;
+#endif
+#if defined(HSV_KERNEL_NEON)
+            return Isa::Neon;
+#endif
+            return Isa::Scalar;
+        }
+
+        Isa active() {
+            static const Isa isa = detect_isa();
+            return isa;
+        }
+    }
+
+    Bounds make_bounds(const cv::Scalar& lower, const cv::Scalar& upper) {
+        Bounds b;
+        for (int c = 0; c < 3; ++c) {
+            b.lower[c] = std::clamp(cvRound(lower[c]), 0, 255);
+            b.upper[c] = std::clamp(cvRound(upper[c]), 0, 255);
+        }
+        return b;
+    }
+
+    namespace {
+        template<int CN>
+        int threshold_row_simd(const uint8_t* src, uint8_t* mask, int width, const Bounds& bounds) {
+            switch (active()) {
+#if defined(HSV_KERNEL_X86)
+                case Isa::Avx2:  return threshold_row_avx2<CN>(src, mask, width, bounds);
+                case Isa::Sse41: return threshold_row_sse41<CN>(src, mask, width, bounds);
+#endif
+#if defined(HSV_KERNEL_NEON)
+                case Isa::Neon:  return threshold_row_neon<CN>(src, mask, width, bounds);
+#endif
+                default: return 0;
+            }
+        }
+    }
+
+    void threshold_row(const uint8_t* src, uint8_t* mask, int width, const Bounds& bounds, int channels) {
+        CV_Assert(channels == 3 || channels == 4);
+        const int x = channels == 4 ? threshold_row_simd<4>(src, mask, width, bounds)
+                                    : threshold_row_simd<3>(src, mask, width, bounds);
+        threshold_row_scalar(src, mask, x, width, channels, bounds);
+    }
+
+    void threshold(const cv::Mat& image, const Bounds& bounds, cv::Mat& mask) {
+        CV_Assert(image.type() == CV_8UC3 || image.type() == CV_8UC4);
+        mask.create(image.size(), CV_8UC1);
+        for (int y = 0; y < image.rows; ++y) {
+            threshold_row(image.ptr<uint8_t>(y), mask.ptr<uint8_t>(y), image.cols, bounds, image.channels());
+        }
+    }
+
+    const char* active_isa() {
+        switch (active()) {
+            case Isa::Avx2:  return "AVX2";
+            case Isa::Sse41: return "SSE4.1";
+            case Isa::Neon:  return "NEON";
+            default:         return "scalar";
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef HSVRANGEKERNEL_H
+#define HSVRANGEKERNEL_H
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+
+// 融合的 BGR -> HSV 阈值核：单次遍历直接输出二值掩码，不生成 HSV 中间图。
+// 结果与 cv::cvtColor(COLOR_BGR2HSV) + cv::inRange 逐位一致（8 位，H 范围 0~180）。
+// 运行时按 CPU 能力选择 AVX2 / SSE4.1 / NEON 实现，否则退回标量实现。
+namespace HsvRangeKernel {
+
+    struct Bounds {
+        int lower[3]; // H, S, V 下界（含）
+        int upper[3]; // H, S, V 上界（含）
+    };
+
+    // 按 cv::inRange 的规则把 Scalar 阈值取整并截断到 [0, 255]
+    Bounds make_bounds(const cv::Scalar& lower, const cv::Scalar& upper);
+
+    // 处理一行：src 为 width * channels 字节（BGR 或 BGRA，A 通道忽略），mask 为 width 字节
+    void threshold_row(const uint8_t* src, uint8_t* mask, int width, const Bounds& bounds, int channels = 3);
+
+    // 处理整幅图像或 ROI 视图（CV_8UC3 / CV_8UC4），输出 CV_8UC1 掩码（0 或 255）
+    void threshold(const cv::Mat& image, const Bounds& bounds, cv::Mat& mask);
+
+    // 当前选中的实现名称，便于日志与基准测试
+    const char* active_isa();
+}
+
+#endif //HSVRANGEKERNEL_H
@@ -1,49 +1,160 @@
 #include "ImageProcessor.h"
+#include "HsvRangeKernel.h"
+#include "HsvLookupTable.h"
 #include "config/Configuration.h"
+#include "config/RuntimeConfig.h"
+#include "utils/BufferPool.h"
+#include <atomic>
+#include <iostream>
 
 namespace ImageProcessor {
 
-    // 辅助函数，用于处理单个ROI区域
+    // 车道 ROI 与帧求交：热加载的 ROI 可能超出画面，越界取子图会在工作线程里抛异常终止整条流水线。
+    // 超出部分按不存在处理，完全在画面外的车道本帧不分割；每次进程只提示一次
+    cv::Rect clip_roi(const cv::Rect& roi, const cv::Size& frame_size) {
+        const cv::Rect clipped = roi & cv::Rect(cv::Point(0, 0), frame_size);
+        if (clipped != roi) {
+            static std::atomic<bool> warned = {false};
+            if (!warned.exchange(true)) {
+                std::cerr << "[Warning] Lane ROI (" << roi.x << ", " << roi.y << ", " << roi.width << ", " << roi.height
+                          << ") exceeds the " << frame_size.width << "x" << frame_size.height << " frame; clipping it." << std::endl;
+            }
+        }
+        return clipped;
+    }
+
+    // 辅助函数，用于处理单个ROI区域（OpenCV 路径）
     // 只需要将 cv::Mat 替换为 cv::UMat
     // OpenCV 会自动处理后台的 GPU 计算
-    void process_single_roi(const cv::UMat& full_image, const cv::Rect& roi, cv::UMat& output_mask) {
+    void process_single_roi_opencv(const cv::UMat& full_image, const cv::Rect& roi, const RuntimeConfig::Snapshot& config, cv::Mat& output_mask) {
         // 1. 从完整图像中提取ROI
         cv::UMat roi_bgr_img = full_image(roi);
 
-        // 2. 转换为HSV色彩空间
+        // 2. 转换为HSV色彩空间（BGRA 零拷贝帧同样适用，A 通道被忽略）
         cv::UMat roi_hsv_img;
         cv::cvtColor(roi_bgr_img, roi_hsv_img, cv::COLOR_BGR2HSV);
 
         // 3. 根据HSV阈值创建掩码
         cv::UMat hsv_mask;
-        cv::inRange(roi_hsv_img, Config::LOWER_HSV, Config::UPPER_HSV, hsv_mask);
+        cv::inRange(roi_hsv_img, config.lower_hsv, config.upper_hsv, hsv_mask);
 
         // 4. 使用形态学操作去噪
         cv::Mat morph_kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(Config::MORPH_KERNEL_SIZE, Config::MORPH_KERNEL_SIZE));
         cv::morphologyEx(hsv_mask, output_mask, cv::MORPH_OPEN, morph_kernel, cv::Point(-1,-1), Config::MORPH_ITERATIONS);
     }
 
-    // 在 process_frame 中也同样使用 UMat
-    ConsumerResult process_frame(const ProducerTask& task) {
-        // 将 task.image (cv::Mat) 转换为 cv::UMat
-        cv::UMat u_image = task.image.getUMat(cv::ACCESS_READ);
+    void initialize() {
+        // 查找表随配置快照一起生成/加载；启动时先取一次，避免首帧卡顿
+        RuntimeConfig::current();
+    }
 
-        cv::UMat mask_A, mask_B;
-        process_single_roi(u_image, Config::ROI_A, mask_A);
-        process_single_roi(u_image, Config::ROI_B, mask_B);
+    // 辅助函数，用于处理单个ROI区域（融合核 / 查找表路径）
+    // BGR 直接阈值化为掩码，结果与 cvtColor + inRange 逐位一致，但不分配 HSV 中间图、只遍历一次内存
+    // 阈值与查找表取自本帧的配置快照，热切换阈值不会让同一帧的不同车道用到不同版本
+    void process_single_roi_fused(const cv::Mat& full_image, const cv::Rect& roi, const RuntimeConfig::Snapshot& config, cv::Mat& output_mask) {
+        // 中间掩码每线程复用；输出掩码随 SegmentedFrame 传给下游，从缓冲池中取
+        thread_local cv::Mat hsv_mask;
+        if (output_mask.empty()) output_mask = BufferPool::instance().make();
+        if (config.hsv_lut) {
+            config.hsv_lut->threshold(full_image(roi), hsv_mask);
+        } else {
+            HsvRangeKernel::threshold(full_image(roi), config.hsv_bounds, hsv_mask);
+        }
 
-        cv::UMat combined_mask = cv::UMat::zeros(task.image.size(), CV_8UC1);
+        cv::Mat morph_kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(Config::MORPH_KERNEL_SIZE, Config::MORPH_KERNEL_SIZE));
+        cv::morphologyEx(hsv_mask, output_mask, cv::MORPH_OPEN, morph_kernel, cv::Point(-1,-1), Config::MORPH_ITERATIONS);
+    }
 
-        mask_A.copyTo(combined_mask(Config::ROI_A));
-        mask_B.copyTo(combined_mask(Config::ROI_B));
+    SegmentedFrame segment_frame(const ProducerTask& task) {
+        const RuntimeConfig::SnapshotPtr config = RuntimeConfig::resolve(task.config);
+        const std::vector<Config::Lane>& lanes = config->lanes;
+        const int lane_count = (int)lanes.size();
+        SegmentedFrame segmented{task.frame_idx, task.image, std::vector<cv::Mat>(lane_count), config, task.timeline};
+        if (Config::HSV_THRESHOLD_MODE != Config::HsvThresholdMode::OpenCV) {
+            // 一个车道一个任务：各车道 ROI 互不依赖，输出写入各自的掩码
+            cv::parallel_for_(cv::Range(0, lane_count), [&](const cv::Range& range) {
+                for (int i = range.start; i < range.end; ++i) {
+                    const cv::Rect roi = clip_roi(lanes[i].roi, task.image.size());
+                    if (!roi.empty()) process_single_roi_fused(task.image, roi, *config, segmented.roi_masks[i]);
+                }
+            }, lane_count);
+        } else {
+            // 将 task.image (cv::Mat) 转换为 cv::UMat
+            // OpenCL 路径本身已在设备上并行，逐车道顺序提交
+            cv::UMat u_image = task.image.getUMat(cv::ACCESS_READ);
+            for (int i = 0; i < lane_count; ++i) {
+                const cv::Rect roi = clip_roi(lanes[i].roi, task.image.size());
+                if (!roi.empty()) process_single_roi_opencv(u_image, roi, *config, segmented.roi_masks[i]);
+            }
+        }
+        return segmented;
+    }
 
-        // 注意：connectedComponentsWithStats 目前在很多后端上不支持 UMat
-        // 所以在这一步需要从 GPU 下载回 CPU
-        cv::Mat final_mask = combined_mask.getMat(cv::ACCESS_READ);
+    // 单个车道的连通域结果：标号为车道内局部编号，合并时再加上前面车道的偏移
+    struct LaneLabels {
         cv::Mat labels, stats, centroids;
-        cv::connectedComponentsWithStats(final_mask, labels, stats, centroids, 8, CV_32S);
+        int count = 0;
+    };
+
+    // 逐车道并行做连通域分析，再按车道顺序合并：把面积达标的连通域平移回整帧坐标，输出紧凑的检测记录。
+    // 只有 KEEP_FULL_FRAME_LABELS 打开时才分配整帧 labels（标号与 Detection::label_id 一致）。
+    ConsumerResult label_frame(const SegmentedFrame& segmented) {
+        const RuntimeConfig::SnapshotPtr config = RuntimeConfig::resolve(segmented.config);
+        const std::vector<Config::Lane>& lanes = config->lanes;
+        const int lane_count = (int)segmented.roi_masks.size();
+        ConsumerResult result{segmented.frame_idx, segmented.original_image, {}, cv::Mat(), config, segmented.timeline};
+        if (Config::KEEP_FULL_FRAME_LABELS) {
+            result.labels = BufferPool::instance().acquire(segmented.original_image.size(), CV_32S);
+            result.labels.setTo(cv::Scalar(0));
+        }
+
+        // 每个工作线程复用自己的一组车道缓冲区，车道任务各写一项
+        thread_local std::vector<LaneLabels> lane_labels;
+        if ((int)lane_labels.size() < lane_count) lane_labels.resize(lane_count);
+        LaneLabels* scratch = lane_labels.data();
+        cv::parallel_for_(cv::Range(0, lane_count), [&](const cv::Range& range) {
+            for (int i = range.start; i < range.end; ++i) {
+                LaneLabels& l = scratch[i];
+                // 完全在画面外的车道没有掩码
+                if (segmented.roi_masks[i].empty()) {
+                    l.count = 0;
+                    continue;
+                }
+                l.count = cv::connectedComponentsWithStats(segmented.roi_masks[i], l.labels, l.stats, l.centroids, 8, CV_32S);
+            }
+        }, lane_count);
+
+        int label_offset = 0;
+        for (int i = 0; i < lane_count; ++i) {
+            // 与分割阶段相同的裁剪结果，掩码坐标以它为原点
+            const cv::Rect roi = lanes[i].roi & cv::Rect(cv::Point(0, 0), segmented.original_image.size());
+            const LaneLabels& l = scratch[i];
+            const int n = l.count;
+            if (n <= 1) continue;
 
-        return {task.frame_idx, task.image, labels, stats, centroids};
+            if (!result.labels.empty()) {
+                cv::add(l.labels, cv::Scalar(label_offset), result.labels(roi), l.labels > 0);
+            }
+            for (int j = 1; j < n; ++j) {
+                const int* stat = l.stats.ptr<int>(j);
+                if (stat[cv::CC_STAT_AREA] < config->min_area) continue;
+                const double* centroid = l.centroids.ptr<double>(j);
+                Detection det;
+                det.label_id = label_offset + j;
+                det.roi_id = i;
+                det.area = stat[cv::CC_STAT_AREA];
+                det.centroid = cv::Point2f((float)(centroid[0] + roi.x), (float)(centroid[1] + roi.y));
+                det.bbox = cv::Rect(stat[cv::CC_STAT_LEFT] + roi.x, stat[cv::CC_STAT_TOP] + roi.y,
+                                    stat[cv::CC_STAT_WIDTH], stat[cv::CC_STAT_HEIGHT]);
+                result.detections.push_back(det);
+            }
+            label_offset += n - 1;
+        }
+        return result;
+    }
+
+    ConsumerResult process_frame(const ProducerTask& task) {
+        return label_frame(segment_frame(task));
     }
 }
 
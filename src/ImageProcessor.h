@@ -1,5 +1,10 @@
 #ifndef IMAGEPROCESSOR_H
 #define IMAGEPROCESSOR_H
 #include "utils/DataTypes.h"
-namespace ImageProcessor { ConsumerResult process_frame(const ProducerTask& task); }
+namespace ImageProcessor {
+    void initialize();                                          // 启动时准备阈值资源（如 HSV 查找表）
+    SegmentedFrame segment_frame(const ProducerTask& task);     // 分割阶段：逐车道并行生成二值掩码
+    ConsumerResult label_frame(const SegmentedFrame& segmented); // 标记阶段：逐车道连通域分析
+    ConsumerResult process_frame(const ProducerTask& task);     // 分割 + 标记
+}
 #endif //IMAGEPROCESSOR_H
\ No newline at end of file
@@ -1,276 +1,453 @@
 #include "ImageTracker.h"
 #include "ImageProcessor.h"
 #include "config/Configuration.h"
-#include "SimpleSerial.h"
 #include "KinectManager.h"
+#include "FakeKinectDevice.h"
+#include "FrameDecoder.h"
+#include "utils/BufferPool.h"
+#include "utils/Trace.h"
 #include <iostream>
 #include <filesystem>
 #include <algorithm>
-#include <fstream>
-#include <iomanip>
-#include <map>
+#include <memory>
 #include <vector>
 #include <string>
 
 namespace fs = std::filesystem;
 
+// 固定节拍限频：到期返回 true 并推进到下一拍；落后超过一拍时从当前时刻重新计时，不补发
+static bool tick_due(CaptureTime& next, CaptureTime now, float rate_hz) {
+    if (rate_hz <= 0.0f) return true;
+    if (now < next) return false;
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(1.0f / rate_hz));
+    next += period;
+    if (next <= now) next = now + period;
+    return true;
+}
+
 // 构造函数
-ImageTracker::ImageTracker(const Settings& config) : m_config(config) {}
+ImageTracker::ImageTracker(const Settings& config) : m_config(config) {
+    ImageProcessor::initialize();
+}
 
 // 析构函数
 ImageTracker::~ImageTracker() {
-    m_is_running = false;
-    for (auto& t : m_threads) {
-        if (t.joinable()) t.join();
-    }
-    if (m_video_writer.isOpened()) {
-        m_video_writer.release();
-    }
+    request_stop();
+    m_pipeline.join();
 }
 
 // --- 数据集模式入口 ---
-void ImageTracker::runFromDataset(SimpleSerial* serial) {
-    m_serial = serial;
-    m_is_running = true;
-
-    for (const auto& entry : fs::directory_iterator(m_config.input_path)) {
-        if (entry.path().extension() == ".png" || entry.path().extension() == ".jpg") {
-            m_image_files.push_back(entry.path().string());
-        }
-    }
-    std::sort(m_image_files.begin(), m_image_files.end());
-    m_total_frames = m_image_files.size();
-    if (m_total_frames == 0) {
-        throw std::runtime_error("No images found in the specified directory!");
+void ImageTracker::runFromDataset(ActuatorLink* actuator) {
+    m_actuator = actuator;
+
+    // 不显示时录制文件的 ROI 裁剪帧不必填充 ROI 外区域
+    m_decoder = std::make_unique<FrameDecoder>(m_config.input_path, Config::DISPLAY_ENABLED);
+    if (const RecordingReader* recording = m_decoder->recording()) {
+        // 录制文件：帧索引直接给出帧数与时间戳，按 REPLAY_START_SECONDS 定位起播帧
+        m_first_frame = recording->find_frame((int64_t)(Config::REPLAY_START_SECONDS * 1e9));
+        std::cout << "[Info] Replaying recording: " << recording->describe();
+        if (m_first_frame) std::cout << ", starting at frame " << m_first_frame;
+        std::cout << std::endl;
+        if (m_first_frame == recording->size()) throw std::runtime_error("No frames to replay in the recording!");
     }
+    m_total_frames = (int)(m_decoder->size() - m_first_frame);
+    m_output_dir = "output/" + m_decoder->name();
+    open_trajectory_output();
+
+    // 回放时每一帧都要处理和录制：各级队列满则阻塞上游
+    m_input_queue.set_overflow_policy(OverflowPolicy::Block);
+    m_visual_queue.set_overflow_policy(OverflowPolicy::Block);
+    // 录制的视频需要每一帧；不录制时与实时模式一样只按显示频率渲染
+    m_render_every_frame = m_config.save_video;
+    m_video_path = m_output_dir + "/" + Config::OUTPUT_VIDEO_FILENAME;
+    const auto replay_begin = std::chrono::steady_clock::now();
+    start_pipeline([this] { producer_thread_from_files(); });
+    m_pipeline.join();
+    m_is_running = false;
 
-    unsigned int num_consumers = (std::max)(1u, std::thread::hardware_concurrency() - 2);
-    if (num_consumers == 0) num_consumers = 1;
+    report_queue_stats();
+    m_decoder->report(std::chrono::duration<double>(std::chrono::steady_clock::now() - replay_begin).count());
+    process_and_output_statistics();
+    std::cout << "[Info] Processing finished for folder: " << m_config.input_path << std::endl;
+}
 
-    m_threads.emplace_back(&ImageTracker::producer_thread_from_files, this, num_consumers);
-    for (unsigned int i = 0; i < num_consumers; ++i) {
-        m_threads.emplace_back(&ImageTracker::consumer_thread, this);
+// --- 实时相机模式入口 ---
+void ImageTracker::runFromCamera(ActuatorLink* actuator) {
+    m_actuator = actuator;
+
+    std::unique_ptr<FrameSource> camera;
+    if (!Config::FAKE_CAMERA_PATH.empty()) {
+        camera = std::make_unique<FakeKinectDevice>(Config::FAKE_CAMERA_PATH, Config::VIDEO_FPS);
+    } else {
+        camera = std::make_unique<KinectManager>();
+    }
+    if (!camera->isOpened()) {
+        throw std::runtime_error("Failed to initialize Kinect camera.");
     }
 
-    int processed_frame_count = 0;
-    while(processed_frame_count < m_total_frames && m_is_running) {
-        ConsumerResult result;
-        if(m_output_queue.try_pop(result)) {
-            m_track_manager.update(result, m_tracked_objects);
-            cv::Mat display_frame = result.original_image.clone();
-            visualize(display_frame, result.frame_idx, m_tracked_objects, result.labels);
-            cv::resize(display_frame, display_frame, Config::DISPLAY_SIZE);
-            cv::imshow("Apple Tracker", display_frame);
-            if (m_config.save_video) m_frame_buffer_for_video.push_back(display_frame);
-
-            auto fired_actions = m_track_manager.getAndClearFiredActions();
-            for (const auto& action : fired_actions) {
-                std::cout << "[ACTION TRIGGERED] Firing action: " << action.action_type << std::endl;
-                if (m_serial && m_serial->isConnected()) m_serial->write(std::string(1, action.action_type));
-            }
-
-            if (cv::waitKey(1) == 27) m_is_running = false;
-            processed_frame_count++;
-        } else {
-            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    // 实时模式下处理跟不上时丢弃最旧帧，保证延迟和内存都有界；显示跟不上则直接跳过该帧
+    m_input_queue.set_overflow_policy(OverflowPolicy::DropOldest);
+    m_visual_queue.set_overflow_policy(OverflowPolicy::DropNewest);
+    m_video_path = "output/live_session.mp4";
+    m_output_dir = "output/live_session";
+    open_trajectory_output();
+    if (Config::RECORD_LIVE_SESSION) {
+        const std::string record_path = "output/live_session" + Config::RECORDING_EXTENSION;
+        try {
+            m_recorder = std::make_unique<RecordingWriter>(record_path, Config::LIVE_RECORDING_PAYLOAD,
+                                                           recording_crop_for_lanes(RuntimeConfig::current()->lanes));
+        } catch (const std::exception& e) {
+            std::cerr << "[Error] " << e.what() << " (continuing without recording)" << std::endl;
         }
     }
+    // 实时模式只录制渲染过的帧，视频帧率与显示频率一致
+    if (Config::DISPLAY_FPS > 0.0f) m_video_fps = (std::min)(Config::VIDEO_FPS, Config::DISPLAY_FPS);
+    start_pipeline([this, &camera] { producer_thread_from_camera(*camera); });
+    m_pipeline.join();
     m_is_running = false;
 
-    for (auto& t : m_threads) {
-        if (t.joinable()) t.join();
+    report_queue_stats();
+    if (m_recorder) {
+        std::cout << "[Info] Recorded " << m_recorder->frames() << " frames ("
+                  << m_recorder->bytes() / (1024.0 * 1024.0) << " MB)" << std::endl;
+        m_recorder.reset();
     }
-
-    cv::destroyAllWindows();
-    save_video();
     process_and_output_statistics();
-    std::cout << "[Info] Processing finished for folder: " << m_config.input_path << std::endl;
 }
 
-// --- 实时相机模式入口 ---
-void ImageTracker::runFromCamera(SimpleSerial* serial) {
-    m_serial = serial;
-    m_is_running = true;
+// 流水线：capture [-> decode] -> segment -> label -> (reorder) -> track -> actuate（按截止时间调度）
+//                                                                      \-> visualize -> encode（按 DISPLAY_FPS 抽样；无界面构建中不存在）
+// 每个阶段阻塞在自己的输入队列上；上游结束时关闭下游队列，结束信号逐级传递
+void ImageTracker::start_pipeline(std::function<void()> capture) {
+    const WorkerCounts workers = worker_counts(m_decoder != nullptr);
+    std::cout << "[Info] Worker threads:";
+    if (m_decoder) std::cout << " decode=" << workers.decode;
+    std::cout << " segment=" << workers.segment << " label=" << workers.label << std::endl;
+
+    m_pipeline.add_source("capture", std::move(capture),
+        [this] {
+            if (m_decoder) m_decode_queue.close();
+            else m_input_queue.close();
+            m_record_queue.close();
+        });
+    if (m_decoder) {
+        // 数据集模式：capture 只按重排窗口放行帧号，解码分散到多个线程；乱序完成的帧由重排缓冲区恢复顺序
+        m_pipeline.add_stage("decode", m_decode_queue, workers.decode,
+            [this](int& frame_idx) { decode_stage(frame_idx); },
+            [this] { m_input_queue.close(); });
+    }
+    if (m_recorder) {
+        m_pipeline.add_stage("record", m_record_queue, 1,
+            [this](RecordedFrame& frame) { record_stage(frame); },
+            [this] { m_recorder->close(); });
+    }
+    m_pipeline.add_stage("segment", m_input_queue, workers.segment,
+        [this](ProducerTask& task) { segment_stage(task); },
+        [this] { m_segmented_queue.close(); });
+    m_pipeline.add_stage("label", m_segmented_queue, workers.label,
+        [this](SegmentedFrame& segmented) { label_stage(segmented); },
+        [this] { m_output_queue.close(); });
+    m_pipeline.add_stage("track", m_output_queue, 1,
+        [this](ConsumerResult& result) { track_stage(result); },
+        [this] { m_dispatcher.close(); m_visual_queue.close(); });
+    // 执行器调度线程：睡眠到最早的截止时间，按时写给执行器；track 结束后触发完剩余动作再退出
+    m_pipeline.add_source("actuate", [this] { m_dispatcher.run(); });
+    if (!Config::DISPLAY_ENABLED) return;
+    // highgui 窗口必须在同一线程内创建、刷新和销毁
+    m_pipeline.add_stage("visualize", m_visual_queue, 1,
+        [this](VisualFrame& frame) { visualize_stage(frame); },
+        [this] {
+#ifndef APPLE_TRACKER_HEADLESS
+            cv::destroyAllWindows();
+#endif
+            m_encode_queue.close();
+        });
+    if (m_config.save_video) {
+        m_encode_queue.set_overflow_policy(m_config.encoder_overflow);
+        m_pipeline.add_stage("encode", m_encode_queue, 1,
+            [this](cv::Mat& frame) { encode_stage(frame); },
+            [this] { if (m_video_writer.isOpened()) m_video_writer.release(); });
+    }
+}
 
-    KinectManager kinect;
-    if (!kinect.isOpened()) {
-        throw std::runtime_error("Failed to initialize Kinect camera.");
+// 停止采集并关闭中间队列；各阶段取完剩余数据后依次退出
+void ImageTracker::request_stop() {
+    m_is_running = false;
+    m_decode_queue.close();
+    m_input_queue.close();
+    m_segmented_queue.close();
+    m_output_queue.close();
+}
+
+void ImageTracker::producer_thread_from_files() {
+    for (int i = 0; i < m_total_frames && m_is_running; ++i) {
+        // 在途帧数不超过重排窗口，解码再快内存也不会增长
+        if (!m_output_queue.wait_for_slot(i)) break;
+        // 放行时即提示预读，解码线程取到该帧时负载多半已在页缓存中
+        m_decoder->prefetch(m_first_frame + i);
+        if (!m_decode_queue.push(i)) break;
     }
+}
 
-    unsigned int num_consumers = (std::max)(1u, std::thread::hardware_concurrency() - 2);
-    if (num_consumers == 0) num_consumers = 1;
-    for (unsigned int i = 0; i < num_consumers; ++i) {
-        m_threads.emplace_back(&ImageTracker::consumer_thread, this);
+void ImageTracker::decode_stage(int& frame_idx) {
+    if (!m_is_running) return;
+    // 解码直接写入池中的缓冲区，同分辨率的帧循环复用同一批 slab；Raw 录制为映射内存的零拷贝视图
+    cv::Mat img = BufferPool::instance().make();
+    const auto read_begin = std::chrono::steady_clock::now();
+    if (!m_decoder->decode(m_first_frame + frame_idx, img)) {
+        // 读图失败：通知重排缓冲区不必等待该帧
+        m_output_queue.skip(frame_idx);
+        return;
     }
+    FrameTimeline timeline;
+    timeline.stamp(FrameTimeline::Captured);
+    Trace::record(Trace::Span::Capture, read_begin, timeline.captured(), frame_idx);
+    // 每帧在解码完成时取一次配置快照，热加载的新配置从之后的帧起生效
+    m_input_queue.push({frame_idx, img, RuntimeConfig::current(), timeline});
+}
 
+void ImageTracker::producer_thread_from_camera(FrameSource& camera) {
     int frame_idx = 0;
-    while (m_is_running) {
-        cv::Mat color_frame;
-        if (!kinect.getNextFrame(color_frame)) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-            continue;
-        }
-
-        m_input_queue.push({frame_idx, color_frame});
+    while (m_is_running && camera.isOpened()) {
+        // getNextFrame 内部阻塞等待设备出帧；BGRA 零拷贝模式下返回的是设备缓冲区视图
+        cv::Mat color_frame = BufferPool::instance().make();
+        const auto wait_begin = std::chrono::steady_clock::now();
+        if (!camera.getNextFrame(color_frame)) continue;
+        // 出帧即打时间戳；曝光到返回的固定延迟可计入各车道的 actuator_lead_ms
+        FrameTimeline timeline;
+        timeline.stamp(FrameTimeline::Captured);
+        Trace::record(Trace::Span::Capture, wait_begin, timeline.captured(), frame_idx);
+
+        if (m_recorder) m_record_queue.push({frame_idx, color_frame, timeline.captured()});
+        m_input_queue.push({frame_idx, color_frame, RuntimeConfig::current(), timeline},
+                           [this](ProducerTask&& evicted) { m_output_queue.skip(evicted.frame_idx); });
+        frame_idx++;
+    }
+}
 
-        ConsumerResult result;
-        if (m_output_queue.try_pop(result)) {
-            m_track_manager.update(result, m_tracked_objects);
+// 各阶段进出时在帧上打点，并把“排队等待”和“本阶段处理”两段记入本线程的延迟直方图
+void ImageTracker::segment_stage(ProducerTask& task) {
+    if (!m_is_running) return;
+    task.timeline.stamp(FrameTimeline::SegmentBegin);
+    SegmentedFrame segmented = ImageProcessor::segment_frame(task);
+    FrameTimeline& t = segmented.timeline;
+    t.stamp(FrameTimeline::SegmentEnd);
+    Trace::record(Trace::Span::WaitSegment, t.at[FrameTimeline::Captured], t.at[FrameTimeline::SegmentBegin], task.frame_idx);
+    Trace::record(Trace::Span::Segment, t.at[FrameTimeline::SegmentBegin], t.at[FrameTimeline::SegmentEnd], task.frame_idx);
+    m_segmented_queue.push(std::move(segmented));
+}
 
-            cv::Mat display_frame = result.original_image.clone();
-            visualize(display_frame, result.frame_idx, m_tracked_objects, result.labels);
+void ImageTracker::label_stage(SegmentedFrame& segmented) {
+    if (!m_is_running) return;
+    segmented.timeline.stamp(FrameTimeline::LabelBegin);
+    ConsumerResult result = ImageProcessor::label_frame(segmented);
+    FrameTimeline& t = result.timeline;
+    t.stamp(FrameTimeline::LabelEnd);
+    Trace::record(Trace::Span::WaitLabel, t.at[FrameTimeline::SegmentEnd], t.at[FrameTimeline::LabelBegin], result.frame_idx);
+    Trace::record(Trace::Span::Label, t.at[FrameTimeline::LabelBegin], t.at[FrameTimeline::LabelEnd], result.frame_idx);
+    m_output_queue.push(result.frame_idx, std::move(result));
+}
 
-            cv::resize(display_frame, display_frame, Config::DISPLAY_SIZE);
-            cv::imshow("Apple Tracker", display_frame);
+void ImageTracker::track_stage(ConsumerResult& result) {
+    FrameTimeline& t = result.timeline;
+    t.stamp(FrameTimeline::TrackBegin);
+    m_track_manager.update(result, m_tracks);
 
-            if (m_config.save_video) {
-                if(!m_video_writer.isOpened()){
-                    std::string output_video_path = "output/live_session.mp4";
-                    fs::create_directories(fs::path(output_video_path).parent_path());
-                    m_video_writer.open(output_video_path, Config::VIDEO_CODEC, Config::VIDEO_FPS, display_frame.size());
-                }
-                if(m_video_writer.isOpened()) m_video_writer.write(display_frame);
-            }
-        }
+    // 新排定的动作立即交给调度线程，到期时间由调度线程保证，不受本线程和渲染的节奏影响
+    for (const auto& action : m_track_manager.takeScheduledActions()) {
+        m_dispatcher.schedule(action);
+    }
 
-        auto fired_actions = m_track_manager.getAndClearFiredActions();
-        for (const auto& action : fired_actions) {
-            std::cout << "[ACTION TRIGGERED] Firing action: " << action.action_type << std::endl;
-            if (m_serial && m_serial->isConnected()) {
-                m_serial->write(std::string(1, action.action_type));
-            }
-        }
+    // 逐目标统计累计本帧被检测到的轨迹并结算退出的轨迹；完整轨迹攒满一块才写盘
+    const int64_t timestamp_ns = frame_timestamp_ns(result);
+    m_track_stats.update(m_tracks, m_track_manager.retiredTracks(), result.frame_idx, timestamp_ns / 1e9);
+    if (m_trajectory) m_trajectory->append(m_tracks, result.frame_idx, timestamp_ns);
+    t.stamp(FrameTimeline::TrackEnd);
+    Trace::record(Trace::Span::WaitTrack, t.at[FrameTimeline::LabelEnd], t.at[FrameTimeline::TrackBegin], result.frame_idx);
+    Trace::record(Trace::Span::Track, t.at[FrameTimeline::TrackBegin], t.at[FrameTimeline::TrackEnd], result.frame_idx);
+
+    // 渲染线程只拿到按显示频率抽样的最新快照；被跳过的帧不复制目标列表，也不占用渲染线程
+    if (!Config::DISPLAY_ENABLED) return;
+    if (!m_render_every_frame && !tick_due(m_next_publish, t.at[FrameTimeline::TrackEnd], Config::DISPLAY_FPS)) return;
+    VisualFrame frame{result.frame_idx, result.original_image, {}, result.config, t};
+    frame.objects.reserve(m_tracks.size());
+    for (int i = 0; i < m_tracks.size(); ++i) frame.objects.push_back(m_tracks.object_at(i));
+    m_visual_queue.push(std::move(frame));
+}
 
-        if (cv::waitKey(1) == 27) {
-            m_is_running = false;
-        }
-        frame_idx++;
-    }
+void ImageTracker::actuate_stage(const PendingAction& action) {
+    // 运行在实时调度线程上：只入发送队列、记录耗时，不等串口写完，也不写控制台；
+    // 每个执行器代码的触发次数与迟到分布由 m_dispatcher.report() 在会话结束时打印
+    const auto fire_begin = std::chrono::steady_clock::now();
+    if (m_actuator) m_actuator->send(action.action_type);
+    const auto fire_end = std::chrono::steady_clock::now();
+    Trace::record(Trace::Span::Actuate, fire_begin, fire_end, action.frame_idx);
+    Trace::record(Trace::Span::CaptureToActuation, action.captured, fire_end, action.frame_idx);
+}
 
-    for (size_t i = 0; i < m_threads.size(); ++i) {
-        m_input_queue.push({-1, cv::Mat()});
+void ImageTracker::visualize_stage(VisualFrame& frame) {
+    if (!m_is_running) return;
+    FrameTimeline& t = frame.timeline;
+    t.stamp(FrameTimeline::VisualizeBegin);
+    // 先缩放到显示尺寸，颜色转换与叠加层都只在小图上进行；缩放结果即可绘制的拷贝，不改动原帧
+    const BufferPool& pool = BufferPool::instance();
+    const cv::Size full_size = frame.original_image.size();
+    cv::Mat display_frame = pool.make();
+    cv::resize(frame.original_image, display_frame, Config::DISPLAY_SIZE);
+    if (display_frame.channels() == 4) {
+        // 零拷贝采集的 BGRA 帧只在显示路径上转换一次
+        cv::Mat bgr = pool.make();
+        cv::cvtColor(display_frame, bgr, cv::COLOR_BGRA2BGR);
+        display_frame = bgr;
     }
-    for (auto& t : m_threads) {
-        if (t.joinable()) t.join();
+    const cv::Point2f scale((float)Config::DISPLAY_SIZE.width / full_size.width, (float)Config::DISPLAY_SIZE.height / full_size.height);
+    visualize(display_frame, scale, frame.frame_idx, frame.objects, *RuntimeConfig::resolve(frame.config));
+
+    // 交给后台编码线程边处理边写盘，内存占用恒定
+    if (m_config.save_video) m_encode_queue.push(display_frame);
+
+    bool escape = false;
+#ifndef APPLE_TRACKER_HEADLESS
+    // 逐帧渲染（录制视频）时窗口仍按显示频率刷新
+    if (!m_render_every_frame || tick_due(m_next_show, t.at[FrameTimeline::VisualizeBegin], Config::DISPLAY_FPS)) {
+        cv::imshow("Apple Tracker", display_frame);
+        escape = cv::waitKey(1) == 27;
     }
-    cv::destroyAllWindows();
-    if(m_video_writer.isOpened()) m_video_writer.release();
+#endif
+    t.stamp(FrameTimeline::VisualizeEnd);
+    Trace::record(Trace::Span::WaitVisualize, t.at[FrameTimeline::TrackEnd], t.at[FrameTimeline::VisualizeBegin], frame.frame_idx);
+    Trace::record(Trace::Span::Visualize, t.at[FrameTimeline::VisualizeBegin], t.at[FrameTimeline::VisualizeEnd], frame.frame_idx);
+    Trace::record(Trace::Span::CaptureToDisplay, t.captured(), t.at[FrameTimeline::VisualizeEnd], frame.frame_idx);
+    if (escape) request_stop();
 }
 
-void ImageTracker::producer_thread_from_files(unsigned int num_consumers) {
-    for (int i = 0; i < m_total_frames && m_is_running; ++i) {
-        cv::Mat img = cv::imread(m_image_files[i]);
-        if (img.empty()) continue;
-        m_input_queue.push({i, img});
-    }
-    for (unsigned int i = 0; i < num_consumers; ++i) {
-        m_input_queue.push({-1, cv::Mat()});
+void ImageTracker::encode_stage(cv::Mat& frame) {
+    if (m_video_path.empty()) return;
+    if (!m_video_writer.isOpened()) {
+        fs::create_directories(fs::path(m_video_path).parent_path());
+        m_video_writer.open(m_video_path, Config::VIDEO_CODEC, m_video_fps, frame.size());
+        if (!m_video_writer.isOpened()) {
+            std::cerr << "[Error] Could not open video writer: " << m_video_path << std::endl;
+            m_video_path.clear();
+            return;
+        }
     }
+    m_video_writer.write(frame);
 }
 
-void ImageTracker::consumer_thread() {
-    while (m_is_running) {
-        ProducerTask task;
-        m_input_queue.wait_and_pop(task);
-        if (task.frame_idx == -1) break;
-        ConsumerResult result = ImageProcessor::process_frame(task);
-        m_output_queue.push(result);
+void ImageTracker::record_stage(RecordedFrame& frame) {
+    if (m_record_epoch == CaptureTime{}) m_record_epoch = frame.captured;
+    m_recorder->write(frame.image, std::chrono::duration_cast<std::chrono::nanoseconds>(frame.captured - m_record_epoch).count());
+}
+
+ImageTracker::WorkerCounts ImageTracker::worker_counts(bool decoding) {
+    // decode / segment / label 三级线程池共享一份核心预算，合计不超过 hardware_concurrency（每级至少 1 个线程）；
+    // 结果经重排后按序输出
+    const unsigned int cores = (std::max)(1u, std::thread::hardware_concurrency());
+    WorkerCounts counts;
+    if (decoding) {
+        // 解码与分割 / 标记同为逐帧重计算，默认各占约三分之一；指定的 DECODE_THREADS 也从预算中扣除，并为后两级各留一个核心
+        const unsigned int requested = Config::DECODE_THREADS ? Config::DECODE_THREADS : cores / 3;
+        counts.decode = (std::max)(1u, (std::min)(requested, cores > 2 ? cores - 2 : 1u));
     }
+    const unsigned int rest = cores > counts.decode ? cores - counts.decode : 0;
+    counts.label = (std::max)(1u, rest / 2);
+    counts.segment = (std::max)(1u, rest - rest / 2);
+    return counts;
+}
+
+void ImageTracker::report_queue_stats() const {
+    auto print_queue = [](const char* name, const auto& c) {
+        std::cout << "[Info] " << name << " queue: capacity=" << c.capacity
+                  << " high_watermark=" << c.high_watermark
+                  << " pushed=" << c.pushed
+                  << " dropped=" << c.dropped
+                  << " producer_waits=" << c.producer_waits
+                  << " consumer_waits=" << c.consumer_waits << std::endl;
+    };
+    if (m_decoder) print_queue("Decode", m_decode_queue.counters());
+    print_queue("Input", m_input_queue.counters());
+    print_queue("Segmented", m_segmented_queue.counters());
+    print_queue("Visual", m_visual_queue.counters());
+    print_queue("Encode", m_encode_queue.counters());
+    if (m_recorder) print_queue("Record", m_record_queue.counters());
+    auto c = m_output_queue.counters();
+    std::cout << "[Info] Reorder buffer: released=" << c.released
+              << " stalls=" << c.stalls
+              << " skipped=" << c.skipped
+              << " late=" << c.late
+              << " max_pending=" << c.max_pending << std::endl;
+    auto p = BufferPool::instance().counters();
+    std::cout << "[Info] Buffer pool: slab_allocations=" << p.slab_allocations
+              << " reuses=" << p.reuses
+              << " returns=" << p.returns
+              << " in_use=" << p.slabs_in_use
+              << " idle=" << p.slabs_idle
+              << " reserved_mb=" << p.bytes_reserved / (1024.0 * 1024.0) << std::endl;
+    m_dispatcher.report();
 }
 
-void ImageTracker::visualize(cv::Mat& display_frame, int frame_idx,
-                           const std::unordered_map<int, TrackedObject>& objects,
-                           const cv::Mat& labels_in_roi) {
-    for (const auto& pair : objects) {
-        const auto& obj = pair.second;
+// 检测框与 ROI 为原图坐标，按 scale 映射到显示帧；文字大小与偏移按显示像素计
+void ImageTracker::visualize(cv::Mat& display_frame, cv::Point2f scale, int frame_idx,
+                           const std::vector<TrackedObject>& objects, const RuntimeConfig::Snapshot& config) {
+    auto to_display = [scale](const cv::Rect& r) {
+        return cv::Rect(cvRound(r.x * scale.x), cvRound(r.y * scale.y), cvRound(r.width * scale.x), cvRound(r.height * scale.y));
+    };
+    for (const auto& obj : objects) {
         if (obj.missed_frames == 0) {
-            cv::rectangle(display_frame, obj.current_bbox, obj.color, 2);
-            cv::Point text_pos(obj.current_bbox.x + Config::OBJECT_ID_TEXT_OFFSET.x, obj.current_bbox.y + Config::OBJECT_ID_TEXT_OFFSET.y);
+            const cv::Rect bbox = to_display(obj.current_bbox);
+            cv::rectangle(display_frame, bbox, obj.color, 2);
+            cv::Point text_pos(bbox.x + Config::OBJECT_ID_TEXT_OFFSET.x, bbox.y + Config::OBJECT_ID_TEXT_OFFSET.y);
             cv::putText(display_frame, std::to_string(obj.assigned_number), text_pos, Config::FONT_FACE, Config::FONT_SCALE_OBJECT_ID, Config::TEXT_COLOR_OBJECT_ID, Config::LINE_THICKNESS);
         }
     }
-    cv::rectangle(display_frame, Config::ROI_A, Config::ROI_RECT_COLOR, Config::LINE_THICKNESS);
-    cv::rectangle(display_frame, Config::ROI_B, Config::ROI_RECT_COLOR, Config::LINE_THICKNESS);
-    cv::putText(display_frame, "Line A", {Config::ROI_A.x, Config::ROI_A.y - 10}, Config::FONT_FACE, 0.8, Config::ROI_RECT_COLOR, 2);
-    cv::putText(display_frame, "Line B", {Config::ROI_B.x, Config::ROI_B.y - 10}, Config::FONT_FACE, 0.8, Config::ROI_RECT_COLOR, 2);
+    for (const auto& lane : config.lanes) {
+        const cv::Rect roi = to_display(lane.roi);
+        cv::rectangle(display_frame, roi, Config::ROI_RECT_COLOR, Config::LINE_THICKNESS);
+        cv::putText(display_frame, "Line " + lane.name, {roi.x, roi.y - 10}, Config::FONT_FACE, 0.8, Config::ROI_RECT_COLOR, 2);
+    }
     cv::putText(display_frame, "Frame: " + std::to_string(frame_idx), Config::FRAME_COUNTER_POS, Config::FONT_FACE, Config::FONT_SCALE_FRAME_COUNTER, Config::FRAME_COUNTER_COLOR, Config::LINE_THICKNESS);
 }
 
-void ImageTracker::save_video() {
-    if (!Config::USE_LIVE_CAMERA && m_config.save_video && !m_frame_buffer_for_video.empty()) {
-        std::string folder_name = fs::path(m_config.input_path).filename().string();
-        std::string output_video_path = "output/" + folder_name + "/" + Config::OUTPUT_VIDEO_FILENAME;
-        fs::create_directories(fs::path(output_video_path).parent_path());
-        cv::VideoWriter writer;
-        writer.open(output_video_path, Config::VIDEO_CODEC, Config::VIDEO_FPS, m_frame_buffer_for_video[0].size());
-        if(writer.isOpened()){
-            for(const auto& frame : m_frame_buffer_for_video){
-                writer.write(frame);
-            }
-        }
+int64_t ImageTracker::frame_timestamp_ns(const ConsumerResult& result) {
+    if (m_decoder) return m_decoder->timestamp_ns(m_first_frame + result.frame_idx);
+    if (m_session_epoch == CaptureTime{}) m_session_epoch = result.timeline.captured();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(result.timeline.captured() - m_session_epoch).count();
+}
+
+void ImageTracker::open_trajectory_output() {
+    if (!Config::SAVE_TRAJECTORIES) return;
+    try {
+        m_trajectory = std::make_unique<TrajectoryWriter>(m_output_dir + "/" + Config::TRAJECTORY_FILENAME);
+    } catch (const std::exception& e) {
+        std::cerr << "[Error] " << e.what() << " (continuing without trajectories)" << std::endl;
     }
 }
 
+// 在流水线结束后调用：结算仍存活的轨迹，写出未满的轨迹块
 void ImageTracker::process_and_output_statistics() {
-    if(Config::USE_LIVE_CAMERA) return;
+    m_track_stats.finish_all();
+    if (m_trajectory) {
+        m_trajectory->close();
+        std::cout << "[Info] Trajectories saved to: " << m_output_dir << "/" << Config::TRAJECTORY_FILENAME
+                  << " (" << m_trajectory->rows() << " rows, " << m_trajectory->bytes() / (1024.0 * 1024.0) << " MB)" << std::endl;
+        m_trajectory.reset();
+    }
 
-    std::string folder_name = fs::path(m_config.input_path).filename().string();
-    if (m_all_stats_data.empty()) {
+    if (m_track_stats.tracks_seen() == 0) {
         std::cout << "No tracking data was collected." << std::endl;
         return;
     }
-    std::map<int, std::vector<TrackingStats>> grouped_stats;
-    for (const auto& stat : m_all_stats_data) {
-        grouped_stats[stat.assigned_number].push_back(stat);
-    }
-    struct Summary {
-        int assigned_number;
-        int frame_count;
-        double speed_pixels_per_sec;
-    };
-    std::vector<Summary> summaries;
-    for (auto const& [assigned_num, group] : grouped_stats) {
-        if (group.size() <= Config::MIN_TRACK_LENGTH_FOR_STATS) continue;
-        if (group.size() < 2 * Config::TRIM_FRAMES_FROM_ENDS + 2) continue;
-        std::vector<TrackingStats> trimmed_group(group.begin() + Config::TRIM_FRAMES_FROM_ENDS, group.end() - Config::TRIM_FRAMES_FROM_ENDS);
-
-        const auto& first_row = trimmed_group.front();
-        const auto& last_row = trimmed_group.back();
-        cv::Point2f start_point(first_row.centroid_x, first_row.centroid_y);
-        cv::Point2f end_point(last_row.centroid_x, last_row.centroid_y);
-        double pixel_distance = cv::norm(end_point - start_point);
-
-        double time_duration = (last_row.frame - first_row.frame) / Config::VIDEO_FPS;
-        double speed_pps = (time_duration > 0) ? (pixel_distance / time_duration) : 0.0;
-        summaries.push_back({assigned_num, (int)trimmed_group.size(), speed_pps});
-    }
+    const std::vector<TrackStatistics::Summary>& summaries = m_track_stats.summaries();
     if (summaries.empty()) {
         std::cout << "No tracks met the criteria for statistical summary." << std::endl;
         return;
     }
-    std::cout << "\n--- Instance Statistics Summary ---" << std::endl;
-    std::cout << std::left << std::setw(20) << "assigned_number"
-              << std::setw(15) << "frame_count"
-              << "speed_pixels_per_sec" << std::endl;
-    for (const auto& summary : summaries) {
-        std::cout << std::left << std::setw(20) << summary.assigned_number
-                  << std::setw(15) << summary.frame_count
-                  << std::fixed << std::setprecision(2) << summary.speed_pixels_per_sec << std::endl;
-    }
+    TrackStatistics::print(summaries);
     if (m_config.save_csv) {
-        std::string csv_path = "output/" + folder_name + "/" + Config::OUTPUT_CSV_FILENAME;
-        fs::create_directories(fs::path(csv_path).parent_path());
-        std::ofstream csv_file(csv_path);
-        if (csv_file.is_open()) {
-            csv_file << "assigned_number,frame_count,speed_pixels_per_sec\n";
-            for (const auto& summary : summaries) {
-                csv_file << summary.assigned_number << ","
-                         << summary.frame_count << ","
-                         << std::fixed << std::setprecision(2) << summary.speed_pixels_per_sec << "\n";
-            }
+        std::string csv_path = m_output_dir + "/" + Config::OUTPUT_CSV_FILENAME;
+        if (TrackStatistics::write_csv(summaries, csv_path)) {
             std::cout << "\nStatistics summary saved to: " << csv_path << std::endl;
-        } else {
-            std::cerr << "[Error] Could not open file for writing: " << csv_path << std::endl;
         }
     }
-}
\ No newline at end of file
+}
@@ -2,20 +2,35 @@
 #define IMAGETRACKER_H
 
 #include "utils/DataTypes.h"
-#include "utils/ThreadSafeQueue.h"
+#include "utils/RingQueue.h"
+#include "utils/ReorderBuffer.h"
+#include "utils/Pipeline.h"
+#include "utils/TrackTable.h"
 #include "TrackManager.h"
-#include "SimpleSerial.h"
+#include "ActuationDispatcher.h"
+#include "ActuatorLink.h"
+#include "FrameRecording.h"
+#include "FrameDecoder.h"
+#include "TrackStatistics.h"
+#include "TrajectoryWriter.h"
+#include "config/Configuration.h"
+#include "config/RuntimeConfig.h"
+#include <memory>
 #include <string>
 #include <vector>
-#include <unordered_map>
 #include <atomic>
 #include <thread>
+#include <functional>
+
+class FrameSource;
 
 class ImageTracker {
 public:
     struct Settings {
         std::string input_path; // 仅用于数据集模式
         bool save_video = true;
+        // 编码线程跟不上时的策略：Block 保证视频不丢帧，DropNewest 保证不拖慢显示
+        OverflowPolicy encoder_overflow = OverflowPolicy::Block;
         bool save_csv = true;
     };
 
@@ -23,34 +38,81 @@ public:
     ~ImageTracker();
 
     // 为两种模式提供不同的入口函数
-    void runFromDataset(SimpleSerial* serial); // 用于本地数据集
-    void runFromCamera(SimpleSerial* serial);  // 用于实时相机
+    void runFromDataset(ActuatorLink* actuator); // 用于本地数据集
+    void runFromCamera(ActuatorLink* actuator);  // 用于实时相机
+    // 停止采集并关闭中间队列，run* 在各阶段退出后照常收尾（汇总、轨迹、录制索引）；任意线程可调用
+    void request_stop();
+
+    // 重排缓冲区的停顿/跳帧计数，供外部观察
+    ReorderBuffer<ConsumerResult>::Counters reorderCounters() const { return m_output_queue.counters(); }
 
 private:
-    void producer_thread_from_files(unsigned int num_consumers);
-    void consumer_thread();
+    void start_pipeline(std::function<void()> capture);
+    struct WorkerCounts {
+        unsigned int decode = 0;
+        unsigned int segment = 1;
+        unsigned int label = 1;
+    };
+    // decoding 为数据集模式（有 decode 阶段）
+    static WorkerCounts worker_counts(bool decoding);
+    void report_queue_stats() const;
 
-    void visualize(cv::Mat& frame, int frame_idx, const std::unordered_map<int, TrackedObject>& objects, const cv::Mat& labels_in_roi);
-    void save_video();
+    // 流水线各阶段
+    void producer_thread_from_files();
+    void producer_thread_from_camera(FrameSource& camera);
+    void decode_stage(int& frame_idx);
+    void segment_stage(ProducerTask& task);
+    void label_stage(SegmentedFrame& segmented);
+    void track_stage(ConsumerResult& result);
+    void actuate_stage(const PendingAction& action);
+    void visualize_stage(VisualFrame& frame);
+    void encode_stage(cv::Mat& frame);
+    void record_stage(RecordedFrame& frame);
+
+    void visualize(cv::Mat& frame, cv::Point2f scale, int frame_idx, const std::vector<TrackedObject>& objects, const RuntimeConfig::Snapshot& config);
+    // 本帧的时间：数据集为帧时间戳，实时模式为相对首帧的采集时刻
+    int64_t frame_timestamp_ns(const ConsumerResult& result);
+    void open_trajectory_output();
     void process_and_output_statistics();
 
     Settings m_config;
-    std::atomic<bool> m_is_running = {true};
-    SimpleSerial* m_serial = nullptr;
+    std::atomic<bool> m_is_running = {true}; // 每个实例只运行一次；不在 run* 中重置，运行前收到的停止请求同样生效
+    ActuatorLink* m_actuator = nullptr;
 
-    std::vector<std::string> m_image_files;
+    // 数据集模式的帧来源；回放中的帧可能是录制文件映射内存的视图，须在流水线结束后才析构
+    std::unique_ptr<FrameDecoder> m_decoder;
+    size_t m_first_frame = 0; // REPLAY_START_SECONDS 定位到的首帧
     int m_total_frames = 0;
+    std::string m_output_dir; // output/<数据集名>；实时模式为 output/live_session
 
-    ThreadSafeQueue<ProducerTask> m_input_queue;
-    ThreadSafeQueue<ConsumerResult> m_output_queue;
-    std::vector<std::thread> m_threads;
+    MpmcQueue<int> m_decode_queue{Config::INPUT_QUEUE_CAPACITY}; // 待解码的帧号（数据集模式）
+    MpmcQueue<ProducerTask> m_input_queue{Config::INPUT_QUEUE_CAPACITY};
+    MpmcQueue<SegmentedFrame> m_segmented_queue{Config::INPUT_QUEUE_CAPACITY};
+    ReorderBuffer<ConsumerResult> m_output_queue{Config::REORDER_WINDOW};
+    SpscQueue<VisualFrame> m_visual_queue{Config::VISUAL_QUEUE_CAPACITY};
+    SpscQueue<cv::Mat> m_encode_queue{Config::ENCODE_QUEUE_CAPACITY};
+    // 实时录制：采集线程把原帧交给录制线程写盘，满则丢弃新帧，不阻塞采集
+    SpscQueue<RecordedFrame> m_record_queue{Config::RECORD_QUEUE_CAPACITY, OverflowPolicy::DropNewest};
+    std::unique_ptr<RecordingWriter> m_recorder;
+    CaptureTime m_record_epoch{};
+    Pipeline m_pipeline;
 
+    ActuationDispatcher m_dispatcher{[this](const PendingAction& action) { actuate_stage(action); }};
     TrackManager m_track_manager;
-    std::unordered_map<int, TrackedObject> m_tracked_objects;
+    TrackTable m_tracks{(int)RuntimeConfig::current()->lanes.size()}; // 按车道分区
 
-    std::vector<TrackingStats> m_all_stats_data;
+    // 逐目标统计在跟踪线程上在线累计，完整轨迹按块流式写盘，两者内存都不随会话时长增长
+    TrackStatistics::Accumulator m_track_stats;
+    std::unique_ptr<TrajectoryWriter> m_trajectory;
+    CaptureTime m_session_epoch{};
+    std::string m_video_path;
+    float m_video_fps = Config::VIDEO_FPS;
     cv::VideoWriter m_video_writer;
-    std::vector<cv::Mat> m_frame_buffer_for_video;
+
+    // 显示限频：跟踪线程按 DISPLAY_FPS 发布快照（m_next_publish），逐帧渲染时由渲染线程限制窗口刷新（m_next_show）
+    bool m_render_every_frame = false;
+    CaptureTime m_next_publish{};
+    CaptureTime m_next_show{};
 };
 
 #endif //IMAGETRACKER_H
\ No newline at end of file
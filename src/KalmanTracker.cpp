@@ -0,0 +1,104 @@
+#include "KalmanTracker.h"
+#include "config/Configuration.h"
+#include <algorithm>
+#include <cmath>
+
+namespace KalmanTracker {
+
+    using namespace Config::Kalman;
+
+    void initialize(TrackTable::Columns& c, int index) {
+        c.cov_pp[index] = MEASUREMENT_NOISE;
+        c.cov_pv[index] = 0.0f;
+        c.cov_vv[index] = INITIAL_VELOCITY_VARIANCE;
+        c.size_w[index] = (float)c.bbox[index].width;
+        c.size_h[index] = (float)c.bbox[index].height;
+        c.size_var[index] = SIZE_MEASUREMENT_NOISE;
+    }
+
+    void predict(TrackTable::Columns& c, int first, int count, float dt) {
+        // F = [1 dt; 0 1]，Q 为离散白噪声加速度模型 q * [dt⁴/4 dt³/2; dt³/2 dt²]
+        const float q_pp = PROCESS_NOISE * dt * dt * dt * dt * 0.25f;
+        const float q_pv = PROCESS_NOISE * dt * dt * dt * 0.5f;
+        const float q_vv = PROCESS_NOISE * dt * dt;
+        const float q_size = SIZE_PROCESS_NOISE * dt;
+        float* x = c.centroid_x.data() + first;
+        float* y = c.centroid_y.data() + first;
+        const float* vx = c.velocity_x.data() + first;
+        const float* vy = c.velocity_y.data() + first;
+        float* pp = c.cov_pp.data() + first;
+        float* pv = c.cov_pv.data() + first;
+        float* vv = c.cov_vv.data() + first;
+        float* sv = c.size_var.data() + first;
+        for (int k = 0; k < count; ++k) {
+            x[k] += vx[k] * dt;
+            y[k] += vy[k] * dt;
+            const float new_pp = pp[k] + 2.0f * dt * pv[k] + dt * dt * vv[k] + q_pp;
+            const float new_pv = pv[k] + dt * vv[k] + q_pv;
+            pp[k] = new_pp;
+            pv[k] = new_pv;
+            vv[k] += q_vv;
+            sv[k] += q_size;
+        }
+    }
+
+    float gate_chi2() {
+        return TRACK_SIZE ? GATE_CHI2_WITH_SIZE : GATE_CHI2_POSITION;
+    }
+
+    void gate_radii(const TrackTable::Columns& c, int first, int count, float* radii) {
+        // 尺寸项非负，位置项单独超过 χ² 的配对一定被拒绝，因此按位置换算的半径是安全的上界
+        const float chi2 = gate_chi2();
+        const float* pp = c.cov_pp.data() + first;
+        for (int k = 0; k < count; ++k) {
+            radii[k] = std::min(std::sqrt(chi2 * (pp[k] + MEASUREMENT_NOISE)), MAX_GATE_RADIUS);
+        }
+    }
+
+    float mahalanobis(const TrackTable::Columns& c, int index, float zx, float zy, float zw, float zh) {
+        const float dx = zx - c.centroid_x[index];
+        const float dy = zy - c.centroid_y[index];
+        float d2 = (dx * dx + dy * dy) / (c.cov_pp[index] + MEASUREMENT_NOISE);
+        if (TRACK_SIZE) {
+            const float dw = zw - c.size_w[index];
+            const float dh = zh - c.size_h[index];
+            d2 += (dw * dw + dh * dh) / (c.size_var[index] + SIZE_MEASUREMENT_NOISE);
+        }
+        return d2;
+    }
+
+    void update(TrackTable::Columns& c, int first, int count, const uint8_t* matched,
+                const float* zx, const float* zy, const float* zw, const float* zh) {
+        float* x = c.centroid_x.data() + first;
+        float* y = c.centroid_y.data() + first;
+        float* vx = c.velocity_x.data() + first;
+        float* vy = c.velocity_y.data() + first;
+        float* pp = c.cov_pp.data() + first;
+        float* pv = c.cov_pv.data() + first;
+        float* vv = c.cov_vv.data() + first;
+        float* w = c.size_w.data() + first;
+        float* h = c.size_h.data() + first;
+        float* sv = c.size_var.data() + first;
+        for (int k = 0; k < count; ++k) {
+            // 未匹配的行增益为 0，状态与协方差保持预测值
+            const float m = matched[k] ? 1.0f : 0.0f;
+            const float s = pp[k] + MEASUREMENT_NOISE;
+            const float kp = m * pp[k] / s;
+            const float kv = m * pv[k] / s;
+            const float ix = m * (zx[k] - x[k]);
+            const float iy = m * (zy[k] - y[k]);
+            x[k] += kp * ix;
+            y[k] += kp * iy;
+            vx[k] += kv * ix;
+            vy[k] += kv * iy;
+            vv[k] -= kv * pv[k];
+            pv[k] *= 1.0f - kp;
+            pp[k] *= 1.0f - kp;
+
+            const float ks = m * sv[k] / (sv[k] + SIZE_MEASUREMENT_NOISE);
+            w[k] += ks * (zw[k] - w[k]);
+            h[k] += ks * (zh[k] - h[k]);
+            sv[k] *= 1.0f - ks;
+        }
+    }
+}
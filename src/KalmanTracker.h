@@ -0,0 +1,33 @@
+#ifndef KALMANTRACKER_H
+#define KALMANTRACKER_H
+
+#include "utils/TrackTable.h"
+#include <cstdint>
+
+// 匀速（CV）卡尔曼滤波，直接在 TrackTable 的 SoA 列上对一个分区的全部轨迹批量运算。
+// x / y 两轴相互独立且噪声参数相同，因此共用同一个 2x2 协方差 [pp pv; pv vv]；
+// bbox 宽高按随机游走建模（Config::Kalman::TRACK_SIZE 打开时参与门限）。
+// 所有循环都是对连续 float 数组的无分支运算，可被编译器自动向量化。
+namespace KalmanTracker {
+
+    // 新轨迹：位置 / 尺寸取检测值，速度取 velocity 列中的初始值
+    void initialize(TrackTable::Columns& c, int index);
+
+    // 批量预测 [first, first + count) 行，dt 为距上次预测的帧数
+    void predict(TrackTable::Columns& c, int first, int count, float dt);
+
+    // 每条轨迹的欧氏搜索半径（由位置新息方差和 χ² 门限换算）
+    void gate_radii(const TrackTable::Columns& c, int first, int count, float* radii);
+
+    // 马氏距离平方（位置，及可选的尺寸）
+    float mahalanobis(const TrackTable::Columns& c, int index, float zx, float zy, float zw, float zh);
+
+    // 门限对应的 χ² 值
+    float gate_chi2();
+
+    // 批量更新：matched[k] 为 0 的行保持预测值；z* 为对应行的观测
+    void update(TrackTable::Columns& c, int first, int count, const uint8_t* matched,
+                const float* zx, const float* zy, const float* zw, const float* zh);
+}
+
+#endif //KALMANTRACKER_H
@@ -1,6 +1,50 @@
 #include "KinectManager.h"
+#include "config/Configuration.h"
 #include <iostream>
 
+namespace {
+    // 把 k4a_image 的生命周期挂到 cv::Mat 的引用计数上：最后一个 Mat 头释放时 unmap -> deallocate，
+    // 此时才调用 k4a_image_release 把缓冲区还给 SDK
+    class K4aImageAllocator : public cv::MatAllocator {
+    public:
+        cv::UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                               cv::AccessFlag flags, cv::UMatUsageFlags usage_flags) const override {
+            // 只用于包装 k4a 缓冲区；对视图再 create 时 Mat 使用默认分配器
+            return cv::Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usage_flags);
+        }
+        bool allocate(cv::UMatData* data, cv::AccessFlag, cv::UMatUsageFlags) const override {
+            return data != nullptr;
+        }
+        void deallocate(cv::UMatData* u) const override {
+            if (!u) return;
+            k4a_image_release(static_cast<k4a_image_t>(u->userdata));
+            delete u;
+        }
+
+        cv::Mat wrap(k4a_image_t image) const {
+            uint8_t* buffer = k4a_image_get_buffer(image);
+            const int width = k4a_image_get_width_pixels(image);
+            const int height = k4a_image_get_height_pixels(image);
+            const size_t stride = (size_t)k4a_image_get_stride_bytes(image);
+            cv::Mat view(height, width, CV_8UC4, buffer, stride);
+            cv::UMatData* u = new cv::UMatData(this);
+            u->data = u->origdata = buffer;
+            u->size = stride * height;
+            u->flags |= cv::UMatData::USER_ALLOCATED;
+            u->userdata = image;
+            u->currAllocator = this;
+            u->refcount = 1;
+            view.u = u;
+            return view;
+        }
+    };
+
+    const K4aImageAllocator& k4a_image_allocator() {
+        static const K4aImageAllocator allocator;
+        return allocator;
+    }
+}
+
 KinectManager::KinectManager() {
     if (K4A_RESULT_SUCCEEDED != k4a_device_open(K4A_DEVICE_DEFAULT, &m_device)) {
         std::cerr << "[ERROR] Kinect: Failed to open device!" << std::endl;
@@ -39,13 +83,18 @@ bool KinectManager::getNextFrame(cv::Mat& colorFrame) {
     if (get_capture_result == K4A_WAIT_RESULT_SUCCEEDED) {
         k4a_image_t color_image = k4a_capture_get_color_image(capture);
         if (color_image != NULL) {
+            // color_image 持有自己的引用，capture 可以立即释放
+            k4a_capture_release(capture);
+            if (Config::CAPTURE_FORMAT == Config::CaptureFormat::BgraZeroCopy) {
+                colorFrame = k4a_image_allocator().wrap(color_image);
+                return true;
+            }
             uint8_t* buffer = k4a_image_get_buffer(color_image);
             int width = k4a_image_get_width_pixels(color_image);
             int height = k4a_image_get_height_pixels(color_image);
-            cv::Mat bgraImage(height, width, CV_8UC4, buffer);
+            cv::Mat bgraImage(height, width, CV_8UC4, buffer, (size_t)k4a_image_get_stride_bytes(color_image));
             cv::cvtColor(bgraImage, colorFrame, cv::COLOR_BGRA2BGR);
             k4a_image_release(color_image);
-            k4a_capture_release(capture);
             return true;
         }
         k4a_capture_release(capture);
@@ -1,18 +1,21 @@
 #ifndef KINECT_MANAGER_H
 #define KINECT_MANAGER_H
 
+#include "FrameSource.h"
 #include <opencv2/opencv.hpp>
 #include <string>
 #include <k4a/k4a.h>
 
-class KinectManager {
+class KinectManager : public FrameSource {
 public:
     KinectManager();
-    ~KinectManager();
-    bool isOpened() const;
-    bool getNextFrame(cv::Mat& colorFrame);
+    ~KinectManager() override;
+    bool isOpened() const override;
+    // BgraZeroCopy 模式下输出直接引用 k4a 缓冲区的 BGRA 视图，不做转换和拷贝；
+    // k4a_image 在该 Mat 及其所有 ROI / 拷贝头析构后才释放
+    bool getNextFrame(cv::Mat& colorFrame) override;
 private:
     k4a_device_t m_device = NULL;
     bool m_is_opened = false;
 };
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,154 @@
+#include "LoopbackTransport.h"
+#include "SerialTransport.h"
+#include <algorithm>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+LoopbackTransport::LoopbackTransport(Mode mode, int baud, int write_timeout_ms)
+    : m_mode(mode), m_baud(baud), m_write_timeout_ms(write_timeout_ms) {}
+
+LoopbackTransport::~LoopbackTransport() {
+    close();
+}
+
+bool LoopbackTransport::open() {
+    close();
+    if (m_mode == Mode::Pty) {
+#ifdef _WIN32
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_error = "pty loopback is not available on Windows";
+        return false;
+#else
+        return open_pty();
+#endif
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_failed_opens > 0) {
+        m_failed_opens--;
+        m_error = "simulated actuator unplugged";
+        return false;
+    }
+    m_open = true;
+    return true;
+}
+
+void LoopbackTransport::close() {
+#ifndef _WIN32
+    if (m_pty_reader.joinable()) {
+        m_pty_stop = true;
+        m_pty_reader.join();
+    }
+    m_pty_slave.reset();
+    if (m_pty_master >= 0) {
+        ::close(m_pty_master);
+        m_pty_master = -1;
+    }
+#endif
+    m_open = false;
+}
+
+bool LoopbackTransport::isOpen() const {
+    return m_open;
+}
+
+size_t LoopbackTransport::write(const char* data, size_t size) {
+    if (!m_open) return 0;
+    if (m_mode == Mode::Pty) {
+        const size_t written = m_pty_slave->write(data, size);
+        if (written == size) return written;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_error = m_pty_slave->lastError();
+        m_open = false;
+        return written;
+    }
+
+    size_t deliver = size;
+    bool fail = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_fail_next_write) {
+            // 拔线发生在本次写的中途：前 m_bytes_before_failure 个字节已到达执行器
+            m_fail_next_write = false;
+            m_error = "simulated actuator unplugged";
+            deliver = (std::min)(size, m_bytes_before_failure);
+            fail = true;
+        }
+    }
+    // 线路时间：8N1 每字节 10 bit
+    std::this_thread::sleep_for(std::chrono::microseconds((int64_t)deliver * 10 * 1000000 / m_baud));
+    record(data, deliver);
+    if (fail) m_open = false;
+    return deliver;
+}
+
+std::string LoopbackTransport::name() const {
+    return m_mode == Mode::Pty ? "pty" : "loopback";
+}
+
+std::string LoopbackTransport::lastError() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_error;
+}
+
+void LoopbackTransport::disconnect(int failed_opens, size_t bytes_before_failure) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_fail_next_write = true;
+    m_failed_opens = failed_opens;
+    m_bytes_before_failure = bytes_before_failure;
+}
+
+std::vector<LoopbackTransport::Received> LoopbackTransport::received() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_received;
+}
+
+void LoopbackTransport::record(const char* data, size_t size) {
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i = 0; i < size; ++i) m_received.push_back({data[i], now});
+}
+
+#ifndef _WIN32
+
+bool LoopbackTransport::open_pty() {
+    auto failed = [this](const std::string& what) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_error = what;
+        close();
+        return false;
+    };
+
+    m_pty_master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (m_pty_master < 0) return failed(std::string("posix_openpt: ") + std::strerror(errno));
+    if (grantpt(m_pty_master) != 0 || unlockpt(m_pty_master) != 0) return failed(std::string("grantpt: ") + std::strerror(errno));
+    const char* slave_name = ptsname(m_pty_master);
+    if (!slave_name) return failed("ptsname failed");
+
+    // 从端按普通串口打开，写入走与真实设备相同的代码路径
+    m_pty_slave = std::make_unique<SerialTransport>(slave_name, m_baud, m_write_timeout_ms);
+    if (!m_pty_slave->open()) return failed(m_pty_slave->lastError());
+
+    m_pty_stop = false;
+    m_pty_reader = std::thread([this] { read_pty(); });
+    m_open = true;
+    return true;
+}
+
+void LoopbackTransport::read_pty() {
+    char buffer[256];
+    while (!m_pty_stop) {
+        pollfd pfd{m_pty_master, POLLIN, 0};
+        if (::poll(&pfd, 1, 20) <= 0) continue;
+        const ssize_t n = ::read(m_pty_master, buffer, sizeof(buffer));
+        if (n > 0) record(buffer, (size_t)n);
+    }
+}
+
+#endif
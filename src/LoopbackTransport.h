@@ -0,0 +1,68 @@
+#ifndef LOOPBACK_TRANSPORT_H
+#define LOOPBACK_TRANSPORT_H
+
+#include "ActuatorTransport.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 模拟执行器，便于脱离硬件测试发送链路（与 FakeKinectDevice 之于相机相同）。
+// - InProcess: 按波特率模拟线路时间（每字节 10 bit），记录收到的字节与到达时刻，可注入断线
+// - Pty（仅 POSIX）: 创建伪终端对，写入经 SerialTransport 走真实的 termios 路径，
+//   后台线程从主端读回，验证串口后端本身
+class LoopbackTransport : public ActuatorTransport {
+public:
+    enum class Mode { InProcess, Pty };
+
+    struct Received {
+        char byte;
+        std::chrono::steady_clock::time_point arrived;
+    };
+
+    LoopbackTransport(Mode mode, int baud, int write_timeout_ms);
+    ~LoopbackTransport() override;
+    LoopbackTransport(const LoopbackTransport&) = delete;
+    LoopbackTransport& operator=(const LoopbackTransport&) = delete;
+
+    bool open() override;
+    void close() override;
+    bool isOpen() const override;
+    size_t write(const char* data, size_t size) override;
+    std::string name() const override;
+    std::string lastError() const override;
+
+    // 模拟拔线：下一次写只送出前 bytes_before_failure 个字节后失败，随后 failed_opens 次重连也失败（仅 InProcess）
+    void disconnect(int failed_opens, size_t bytes_before_failure = 0);
+    // 目前为止“执行器”收到的全部字节（任意线程可调用）
+    std::vector<Received> received() const;
+
+private:
+    void record(const char* data, size_t size);
+#ifndef _WIN32
+    bool open_pty();
+    void read_pty();
+#endif
+
+    Mode m_mode;
+    int m_baud;
+    int m_write_timeout_ms;
+    bool m_open = false;
+
+    mutable std::mutex m_mutex;
+    std::vector<Received> m_received;
+    std::string m_error;
+    bool m_fail_next_write = false;
+    int m_failed_opens = 0;
+    size_t m_bytes_before_failure = 0;
+
+    std::unique_ptr<ActuatorTransport> m_pty_slave;
+    int m_pty_master = -1;
+    std::atomic<bool> m_pty_stop = {false};
+    std::thread m_pty_reader;
+};
+
+#endif //LOOPBACK_TRANSPORT_H
@@ -0,0 +1,160 @@
+#include "SerialTransport.h"
+#include <chrono>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+SerialTransport::SerialTransport(std::string port, int baud, int write_timeout_ms)
+    : m_port(std::move(port)), m_baud(baud), m_write_timeout_ms(write_timeout_ms) {}
+
+SerialTransport::~SerialTransport() {
+    close();
+}
+
+bool SerialTransport::fail(const std::string& what) {
+    m_error = what;
+    close();
+    return false;
+}
+
+#ifdef _WIN32
+
+bool SerialTransport::open() {
+    close();
+    // COM10 及以上必须使用设备命名空间路径
+    const std::string path = m_port.rfind("\\\\.\\", 0) == 0 ? m_port : "\\\\.\\" + m_port;
+    m_handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m_handle == INVALID_HANDLE_VALUE) return fail("could not open port (error " + std::to_string(GetLastError()) + ")");
+
+    DCB dcb = {0};
+    dcb.DCBlength = sizeof(dcb);
+    if (!GetCommState(m_handle, &dcb)) return fail("could not get port state");
+    dcb.BaudRate = (DWORD)m_baud;
+    dcb.ByteSize = 8;
+    dcb.StopBits = ONESTOPBIT;
+    dcb.Parity = NOPARITY;
+    dcb.fOutxCtsFlow = FALSE;
+    dcb.fRtsControl = RTS_CONTROL_ENABLE;
+    if (!SetCommState(m_handle, &dcb)) return fail("could not set port state");
+
+    COMMTIMEOUTS timeouts = {0};
+    timeouts.WriteTotalTimeoutConstant = (DWORD)m_write_timeout_ms;
+    timeouts.WriteTotalTimeoutMultiplier = 0;
+    if (!SetCommTimeouts(m_handle, &timeouts)) return fail("could not set port timeouts");
+    return true;
+}
+
+void SerialTransport::close() {
+    if (m_handle != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_handle);
+        m_handle = INVALID_HANDLE_VALUE;
+    }
+}
+
+bool SerialTransport::isOpen() const {
+    return m_handle != INVALID_HANDLE_VALUE;
+}
+
+size_t SerialTransport::write(const char* data, size_t size) {
+    if (!isOpen()) return 0;
+    DWORD written = 0;
+    // 失败或超时时 written 仍为已送出的字节数
+    if (!WriteFile(m_handle, data, (DWORD)size, &written, NULL)) {
+        fail("write failed (error " + std::to_string(GetLastError()) + ")");
+    } else if (written != size) {
+        fail("write timed out");
+    }
+    return written;
+}
+
+#else
+
+namespace {
+    bool to_speed(int baud, speed_t& speed) {
+        switch (baud) {
+            case 1200: speed = B1200; return true;
+            case 2400: speed = B2400; return true;
+            case 4800: speed = B4800; return true;
+            case 9600: speed = B9600; return true;
+            case 19200: speed = B19200; return true;
+            case 38400: speed = B38400; return true;
+            case 57600: speed = B57600; return true;
+            case 115200: speed = B115200; return true;
+            case 230400: speed = B230400; return true;
+            default: return false;
+        }
+    }
+}
+
+bool SerialTransport::open() {
+    close();
+    speed_t speed;
+    if (!to_speed(m_baud, speed)) {
+        m_error = "unsupported baud rate " + std::to_string(m_baud);
+        return false;
+    }
+    // 非阻塞打开：既不等待调制解调器信号，写入也不会无限期阻塞
+    m_fd = ::open(m_port.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (m_fd < 0) return fail(std::string("could not open port: ") + std::strerror(errno));
+
+    termios tty{};
+    if (tcgetattr(m_fd, &tty) != 0) return fail(std::string("tcgetattr: ") + std::strerror(errno));
+    cfmakeraw(&tty);
+    cfsetispeed(&tty, speed);
+    cfsetospeed(&tty, speed);
+    tty.c_cflag &= ~(CSTOPB | PARENB | CRTSCTS);
+    tty.c_cflag |= CS8 | CLOCAL | CREAD;
+    tty.c_cc[VMIN] = 0;
+    tty.c_cc[VTIME] = 0;
+    if (tcsetattr(m_fd, TCSANOW, &tty) != 0) return fail(std::string("tcsetattr: ") + std::strerror(errno));
+    tcflush(m_fd, TCIOFLUSH);
+    return true;
+}
+
+void SerialTransport::close() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool SerialTransport::isOpen() const {
+    return m_fd >= 0;
+}
+
+size_t SerialTransport::write(const char* data, size_t size) {
+    if (!isOpen()) return 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_write_timeout_ms);
+    size_t written = 0;
+    // 出错时返回已写出的字节数，由调用方只重发剩余部分
+    auto failed = [&](const std::string& what) {
+        fail(what);
+        return written;
+    };
+    while (written < size) {
+        const ssize_t n = ::write(m_fd, data + written, size - written);
+        if (n > 0) {
+            written += (size_t)n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) return failed(std::string("write failed: ") + std::strerror(errno));
+
+        // 内核发送缓冲区已满：等待可写，不超过剩余的写超时
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+        if (left <= 0) return failed("write timed out");
+        pollfd pfd{m_fd, POLLOUT, 0};
+        const int ready = ::poll(&pfd, 1, (int)left);
+        if (ready < 0 && errno != EINTR) return failed(std::string("poll failed: ") + std::strerror(errno));
+        if (ready > 0 && (pfd.revents & (POLLERR | POLLHUP | POLLNVAL))) return failed("port disconnected");
+    }
+    return written;
+}
+
+#endif
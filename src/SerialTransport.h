@@ -0,0 +1,41 @@
+#ifndef SERIAL_TRANSPORT_H
+#define SERIAL_TRANSPORT_H
+
+#include "ActuatorTransport.h"
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// 串口通道：8N1、无流控。Windows 使用 CreateFile + DCB + COMMTIMEOUTS，
+// POSIX 使用非阻塞 fd + termios 原始模式，写满内核缓冲区时 poll 等待，不超过写超时。
+class SerialTransport : public ActuatorTransport {
+public:
+    SerialTransport(std::string port, int baud, int write_timeout_ms);
+    ~SerialTransport() override;
+    SerialTransport(const SerialTransport&) = delete;
+    SerialTransport& operator=(const SerialTransport&) = delete;
+
+    bool open() override;
+    void close() override;
+    bool isOpen() const override;
+    size_t write(const char* data, size_t size) override;
+    std::string name() const override { return m_port; }
+    std::string lastError() const override { return m_error; }
+
+private:
+    bool fail(const std::string& what);
+
+    std::string m_port;
+    std::string m_error;
+    int m_baud;
+    int m_write_timeout_ms;
+#ifdef _WIN32
+    HANDLE m_handle = INVALID_HANDLE_VALUE;
+#else
+    int m_fd = -1;
+#endif
+};
+
+#endif //SERIAL_TRANSPORT_H
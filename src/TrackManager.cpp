@@ -1,12 +1,13 @@
 #include "TrackManager.h"
 #include "config/Configuration.h"
-#include "hungarian/Hungarian.h"
+#include "KalmanTracker.h"
+#include "config/RuntimeConfig.h"
 #include <set>
 #include <iostream>
 #include <string>
 #include <algorithm>
+#include <cmath>
 #include <vector>
-#include <functional>
 
 // --- 颜色定义 ---
 const std::string ANSI_COLOR_CYAN   = "\033[36m";
@@ -24,132 +25,213 @@ std::string getOrdinal(int n) {
     }
 }
 
-TrackManager::TrackManager() {
-    m_next_number_A = Config::START_NUMBER_A;
-    m_next_number_B = Config::START_NUMBER_B;
+TrackManager::TrackManager(Config::MotionModel motion_model) : m_motion_model(motion_model) {
+    // 车道数量在启动后固定（热加载拒绝增删车道），编号区间可以变化
+    const RuntimeConfig::SnapshotPtr config = RuntimeConfig::current();
+    m_lanes.resize(config->lanes.size());
+    for (size_t l = 0; l < m_lanes.size(); ++l) m_lanes[l].next_number = config->lanes[l].start_number;
     m_colors = {{255,0,0},{0,255,0},{0,0,255},{255,255,0},{0,255,255},{255,0,255},{128,0,0},{0,128,0},{0,0,128},{128,128,0},{0,128,128},{128,0,128}};
 }
 
-void TrackManager::update(const ConsumerResult& result, std::unordered_map<int, TrackedObject>& tracked_objects) {
-    std::vector<Detection> all_detections;
-    for (int i = 1; i < result.stats.rows; ++i) {
-        if (result.stats.at<int>(i, cv::CC_STAT_AREA) >= Config::MIN_AREA_THRESHOLD) {
-            Detection det;
-            det.label_id = i;
-            det.centroid = cv::Point2f(result.centroids.at<double>(i, 0), result.centroids.at<double>(i, 1));
-            det.bbox = cv::Rect(result.stats.at<int>(i, cv::CC_STAT_LEFT), result.stats.at<int>(i, cv::CC_STAT_TOP), result.stats.at<int>(i, cv::CC_STAT_WIDTH), result.stats.at<int>(i, cv::CC_STAT_HEIGHT));
-            all_detections.push_back(det);
-        }
+void TrackManager::update(const ConsumerResult& result, TrackTable& tracks) {
+    const RuntimeConfig::SnapshotPtr config = RuntimeConfig::resolve(result.config);
+    // 实时模式可能丢帧：按帧号差外推
+    const float dt = m_last_frame_idx < 0 ? 1.0f : (float)(std::max)(1, result.frame_idx - m_last_frame_idx);
+    // 实时模式按相邻采集时刻估计实际帧间隔（数据集回放读盘速度与拍摄帧率无关，保持标称值）
+    if (config->use_live_camera && m_last_frame_idx >= 0 && result.timeline.captured() > m_capture_time) {
+        const float period = std::chrono::duration<float>(result.timeline.captured() - m_capture_time).count() / dt;
+        m_frame_period_s = m_frame_period_s * 0.9f + period * 0.1f;
     }
+    m_last_frame_idx = result.frame_idx;
+    m_capture_time = result.timeline.captured();
 
-    auto process_roi = [&](const cv::Rect& roi,
-                           int& next_assigned_number,
-                           int& exit_counter,
-                           const std::set<int>& sorting_sequence,
-                           char action_char) {
+    m_retired.clear();
+    for (auto& lane : m_lanes) lane.detections.clear();
+    for (const auto& det : result.detections) {
+        m_lanes[det.roi_id].detections.push_back(det);
+    }
 
-        std::vector<Detection> roi_detections;
-        for (const auto& det : all_detections) {
-            if (roi.contains(det.centroid)) {
-                roi_detections.push_back(det);
-            }
-        }
+    // 第一阶段各车道只读写自己分区内的行，列不扩容，可以一个车道一个任务并行；
+    // 每帧工作量很小时调度开销大于收益，串行处理
+    const int lane_count = (int)m_lanes.size();
+    if (lane_count > 1 && tracks.size() + (int)result.detections.size() >= Config::PARALLEL_LANE_MIN_WORK) {
+        cv::parallel_for_(cv::Range(0, lane_count), [&](const cv::Range& range) {
+            for (int l = range.start; l < range.end; ++l) associate_lane(l, *config, tracks, dt);
+        }, lane_count);
+    } else {
+        for (int l = 0; l < lane_count; ++l) associate_lane(l, *config, tracks, dt);
+    }
 
-        std::vector<int> roi_track_ids;
-        for (const auto& pair : tracked_objects) {
-            if (roi.contains(pair.second.centroid)) {
-                roi_track_ids.push_back(pair.first);
-            }
-        }
+    // 第二阶段增删行会移动后续分区，按车道顺序串行执行（编号、颜色与日志顺序保持确定）
+    for (int l = 0; l < lane_count; ++l) retire_and_spawn(l, *config, tracks);
+}
 
-        std::set<int> matched_track_ids;
-        std::set<int> matched_detection_labels;
-
-        if (!roi_track_ids.empty() && !roi_detections.empty()) {
-            std::vector<std::vector<double>> cost_matrix(roi_track_ids.size(), std::vector<double>(roi_detections.size(), 1e6));
-            for (size_t i = 0; i < roi_track_ids.size(); ++i) {
-                const auto& obj = tracked_objects.at(roi_track_ids[i]);
-                cv::Point2f predicted_pos = obj.centroid + obj.velocity;
-                for (size_t j = 0; j < roi_detections.size(); ++j) {
-                    double dist = cv::norm(predicted_pos - roi_detections[j].centroid);
-                    if (dist < Config::MAX_DISTANCE_FOR_TRACKING) cost_matrix[i][j] = dist;
-                }
-            }
-            HungarianAlgorithm solver;
-            std::vector<int> assignment;
-            solver.Solve(cost_matrix, assignment);
-
-            for (size_t i = 0; i < assignment.size(); ++i) {
-                if (assignment[i] != -1 && cost_matrix[i][assignment[i]] < Config::MAX_DISTANCE_FOR_TRACKING) {
-                    int tid = roi_track_ids[i];
-                    const auto& det = roi_detections[assignment[i]];
-                    TrackedObject& obj = tracked_objects.at(tid);
-                    obj.velocity = (obj.velocity * 0.5) + ((det.centroid - obj.centroid) * 0.5);
-                    obj.centroid = det.centroid;
-                    obj.missed_frames = 0;
-                    obj.current_label_id = det.label_id;
-                    obj.current_bbox = det.bbox;
-                    matched_track_ids.insert(tid);
-                    matched_detection_labels.insert(det.label_id);
-                }
-            }
+void TrackManager::associate_lane(int lane, const RuntimeConfig::Snapshot& config, TrackTable& tracks, float dt) {
+    LaneState& s = m_lanes[lane];
+    const std::vector<Detection>& roi_detections = s.detections;
+    const bool kalman = m_motion_model == Config::MotionModel::Kalman;
+
+    // 轨迹表按车道分区存放：本车道的轨迹就是 [first, first + count) 这一段连续行
+    TrackTable::Columns& c = tracks.columns();
+    const int first = tracks.begin(lane);
+    const int count = tracks.end(lane) - first;
+    s.track_matched.assign(count, 0);
+    s.detection_matched.assign(roi_detections.size(), 0);
+
+    // 卡尔曼模式每帧都外推全部轨迹（包括被遮挡的），质心列即为预测位置
+    if (kalman) KalmanTracker::predict(c, first, count, dt);
+
+    if (count > 0 && !roi_detections.empty()) {
+        // 预测位置建网格索引，只比较相邻格子内的配对，再按候选图的连通分量分别求解
+        s.predicted_positions.resize(count);
+        const float* cx = c.centroid_x.data() + first;
+        const float* cy = c.centroid_y.data() + first;
+        const float* vx = c.velocity_x.data() + first;
+        const float* vy = c.velocity_y.data() + first;
+        const float step = kalman ? 0.0f : 1.0f;
+        for (int k = 0; k < count; ++k) {
+            s.predicted_positions[k] = cv::Point2f(cx[k] + step * vx[k], cy[k] + step * vy[k]);
         }
+        s.detection_positions.clear();
+        for (const auto& det : roi_detections) s.detection_positions.push_back(det.centroid);
 
-        for (int tid : roi_track_ids) {
-            if (matched_track_ids.find(tid) == matched_track_ids.end()) {
-                tracked_objects.at(tid).missed_frames++;
-                tracked_objects.at(tid).current_label_id = -1;
-            }
+        if (kalman) {
+            s.gate_radii.resize(count);
+            KalmanTracker::gate_radii(c, first, count, s.gate_radii.data());
+            s.associator.associate(s.predicted_positions, s.gate_radii, s.detection_positions,
+                [&](int k, int j) {
+                    const Detection& det = roi_detections[j];
+                    return KalmanTracker::mahalanobis(c, first + k, det.centroid.x, det.centroid.y,
+                                                      (float)det.bbox.width, (float)det.bbox.height);
+                },
+                KalmanTracker::gate_chi2(), s.assignment);
+        } else {
+            s.associator.associate(s.predicted_positions, s.detection_positions, config.max_distance, s.assignment);
         }
 
-        for (const auto& det : roi_detections) {
-            if (matched_detection_labels.find(det.label_id) == matched_detection_labels.end()) {
-                TrackedObject new_obj;
-                new_obj.unique_id = m_next_unique_id++;
-                new_obj.assigned_number = next_assigned_number++;
-                new_obj.centroid = det.centroid;
-                new_obj.velocity = Config::INITIAL_MOVEMENT;
-                new_obj.color = m_colors[m_color_index++ % m_colors.size()];
-                new_obj.current_label_id = det.label_id;
-                new_obj.current_bbox = det.bbox;
-                tracked_objects[new_obj.unique_id] = new_obj;
+        if (kalman) {
+            s.measurement_x.assign(count, 0.0f);
+            s.measurement_y.assign(count, 0.0f);
+            s.measurement_w.assign(count, 0.0f);
+            s.measurement_h.assign(count, 0.0f);
+        }
+        for (int k = 0; k < count; ++k) {
+            if (s.assignment[k] == -1) continue;
+            const int i = first + k;
+            const auto& det = roi_detections[s.assignment[k]];
+            if (kalman) {
+                s.measurement_x[k] = det.centroid.x;
+                s.measurement_y[k] = det.centroid.y;
+                s.measurement_w[k] = (float)det.bbox.width;
+                s.measurement_h[k] = (float)det.bbox.height;
+            } else {
+                c.velocity_x[i] = c.velocity_x[i] * 0.5f + (det.centroid.x - c.centroid_x[i]) * 0.5f;
+                c.velocity_y[i] = c.velocity_y[i] * 0.5f + (det.centroid.y - c.centroid_y[i]) * 0.5f;
+                c.centroid_x[i] = det.centroid.x;
+                c.centroid_y[i] = det.centroid.y;
             }
+            c.label_id[i] = det.label_id;
+            c.bbox[i] = det.bbox;
+            c.seen_x[i] = det.centroid.x;
+            c.seen_y[i] = det.centroid.y;
+            c.seen_time[i] = m_capture_time;
+            s.track_matched[k] = 1;
+            s.detection_matched[s.assignment[k]] = 1;
+        }
+        if (kalman) {
+            KalmanTracker::update(c, first, count, s.track_matched.data(), s.measurement_x.data(),
+                                  s.measurement_y.data(), s.measurement_w.data(), s.measurement_h.data());
         }
+    }
 
-        for (auto it = roi_track_ids.begin(); it != roi_track_ids.end(); ++it) {
-            if (tracked_objects.count(*it) && tracked_objects.at(*it).missed_frames > Config::MAX_MISSED_FRAMES) {
-                const TrackedObject& dead_object = tracked_objects.at(*it);
-                exit_counter++;
-                std::cout << ANSI_COLOR_CYAN << "[INFO] Target #" << dead_object.assigned_number << " exited from Line " << action_char
-                          << ". It was the " << getOrdinal(exit_counter) << " object on this line." << ANSI_COLOR_RESET << std::endl;
-
-                if (sorting_sequence.count(dead_object.assigned_number)) {
-                    auto trigger_time = std::chrono::steady_clock::now() + std::chrono::milliseconds(Config::ACTION_DELAY_MS);
-                    m_pending_actions.push_back({action_char, trigger_time});
-                    std::cout << ANSI_COLOR_GREEN << "[ACTION BY ID] Queued action '" << action_char << "' for target #" << dead_object.assigned_number << "." << ANSI_COLOR_RESET << std::endl;
-                } else {
-                    std::cout << ANSI_COLOR_YELLOW << "[SKIP BY ID] Target #" << dead_object.assigned_number << " not in sorting sequence for Line " << action_char << "." << ANSI_COLOR_RESET << std::endl;
-                }
-                tracked_objects.erase(*it);
-            }
+    // 丢失计数：匹配上的清零，未匹配的加一
+    int* missed = c.missed_frames.data() + first;
+    int* label = c.label_id.data() + first;
+    const uint8_t* matched = s.track_matched.data();
+    for (int k = 0; k < count; ++k) {
+        missed[k] = matched[k] ? 0 : missed[k] + 1;
+        label[k] = matched[k] ? label[k] : -1;
+    }
+}
+
+void TrackManager::retire_and_spawn(int lane, const RuntimeConfig::Snapshot& config, TrackTable& tracks) {
+    LaneState& s = m_lanes[lane];
+    const Config::Lane& lane_config = config.lanes[lane];
+    const bool kalman = m_motion_model == Config::MotionModel::Kalman;
+    TrackTable::Columns& c = tracks.columns();
+    const int first = tracks.begin(lane);
+
+    // 先删除退出的轨迹再插入新轨迹：倒序遍历，swap-remove 换进来的行都已检查过
+    for (int i = tracks.end(lane) - 1; i >= first; --i) {
+        if (c.missed_frames[i] <= config.max_missed_frames) continue;
+        const int assigned_number = c.assigned_number[i];
+        s.exit_counter++;
+        if (m_verbose) std::cout << ANSI_COLOR_CYAN << "[INFO] Target #" << assigned_number << " exited from Line " << lane_config.name
+                  << ". It was the " << getOrdinal(s.exit_counter) << " object on this line." << ANSI_COLOR_RESET << std::endl;
+
+        if (lane_config.sort_sequence.count(assigned_number)) {
+            const auto trigger_time = arrival_time(lane_config, config, c, i);
+            m_pending_actions.push_back({lane_config.action_code, trigger_time, m_last_frame_idx, m_capture_time});
+            const auto in_ms = std::chrono::duration_cast<std::chrono::milliseconds>(trigger_time - std::chrono::steady_clock::now()).count();
+            if (m_verbose) std::cout << ANSI_COLOR_GREEN << "[ACTION BY ID] Queued action '" << lane_config.action_code << "' for target #" << assigned_number
+                                     << " in " << in_ms << " ms." << ANSI_COLOR_RESET << std::endl;
+        } else if (m_verbose) {
+            std::cout << ANSI_COLOR_YELLOW << "[SKIP BY ID] Target #" << assigned_number << " not in sorting sequence for Line " << lane_config.name << "." << ANSI_COLOR_RESET << std::endl;
         }
-    };
+        m_retired.push_back(c.unique_id[i]);
+        tracks.erase_at(i);
+    }
 
-    process_roi(Config::ROI_A, m_next_number_A, m_exit_counter_A, Config::SortingLogic::SEQUENCE_A, 'A');
-    process_roi(Config::ROI_B, m_next_number_B, m_exit_counter_B, Config::SortingLogic::SEQUENCE_B, 'B');
+    // 编号区间被热加载修改后，从新区间的起点继续编号
+    if (s.next_number < lane_config.start_number || s.next_number > lane_config.end_number) {
+        s.next_number = lane_config.start_number;
+    }
+    for (size_t j = 0; j < s.detections.size(); ++j) {
+        if (s.detection_matched[j]) continue;
+        const auto& det = s.detections[j];
+        TrackedObject new_obj;
+        new_obj.unique_id = m_next_unique_id++;
+        new_obj.assigned_number = s.next_number;
+        s.next_number = s.next_number < lane_config.end_number ? s.next_number + 1 : lane_config.start_number;
+        new_obj.centroid = det.centroid;
+        new_obj.velocity = config.initial_movement;
+        new_obj.color = m_colors[m_color_index++ % m_colors.size()];
+        new_obj.current_label_id = det.label_id;
+        new_obj.current_bbox = det.bbox;
+        const TrackTable::Handle handle = tracks.insert(lane, new_obj);
+        const int index = tracks.index_of(handle);
+        c.seen_time[index] = m_capture_time;
+        if (kalman) KalmanTracker::initialize(c, index);
+    }
 }
 
-std::vector<PendingAction> TrackManager::getAndClearFiredActions() {
-    std::vector<PendingAction> fired_actions;
-    auto now = std::chrono::steady_clock::now();
-    auto it = std::remove_if(m_pending_actions.begin(), m_pending_actions.end(),
-        [&](const PendingAction& action) {
-            if (now >= action.trigger_time) {
-                fired_actions.push_back(action);
-                return true;
-            }
-            return false;
-        });
-    m_pending_actions.erase(it, m_pending_actions.end());
-    return fired_actions;
+std::chrono::steady_clock::time_point TrackManager::arrival_time(const Config::Lane& lane_config, const RuntimeConfig::Snapshot& config,
+                                                                 const TrackTable::Columns& c, int index) const {
+    const auto seen = c.seen_time[index];
+    const auto fallback = seen + std::chrono::milliseconds(config.action_delay_ms);
+    if (!lane_config.has_actuator_line()) return fallback;
+
+    // 直线 a-b 的法向 n：到达时间 t 满足 n·(p + v t - a) = 0
+    const cv::Vec4f& line = lane_config.actuator_line;
+    const float nx = -(line[3] - line[1]);
+    const float ny = line[2] - line[0];
+    const float vx = c.velocity_x[index] / m_frame_period_s;
+    const float vy = c.velocity_y[index] / m_frame_period_s;
+    const float closing = nx * vx + ny * vy;
+    const float distance = nx * (line[0] - c.seen_x[index]) + ny * (line[1] - c.seen_y[index]);
+    // 平行于直线运动或速度过小：预测不可信，退回固定延时
+    if (std::abs(closing) < 1e-6f) return fallback;
+    const float t = distance / closing;
+    // 最后观测时已越过直线：立即触发（返回已过去的时刻，调度器收到即执行），不再额外等待固定延时
+    if (t < 0.0f) return seen;
+    if (t > Config::MAX_ARRIVAL_SECONDS) return fallback;
+
+    return seen + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(t))
+           - std::chrono::milliseconds(lane_config.actuator_lead_ms);
+}
+
+std::vector<PendingAction> TrackManager::takeScheduledActions() {
+    std::vector<PendingAction> scheduled;
+    scheduled.swap(m_pending_actions);
+    return scheduled;
 }
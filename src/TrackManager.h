@@ -2,34 +2,64 @@
 #define TRACKMANAGER_H
 
 #include "utils/DataTypes.h"
-#include <unordered_map>
+#include "utils/TrackTable.h"
+#include "GatedAssociator.h"
+#include "config/Configuration.h"
+#include "config/RuntimeConfig.h"
+#include <cstdint>
 #include <vector>
 #include <chrono>
 
-// PendingAction 结构体保持不变
-struct PendingAction {
-    char action_type; // 'A' 或 'B'
-    std::chrono::steady_clock::time_point trigger_time;
-};
-
 class TrackManager {
 public:
-    TrackManager();
-    void update(const ConsumerResult& result, std::unordered_map<int, TrackedObject>& tracked_objects);
-    std::vector<PendingAction> getAndClearFiredActions();
+    explicit TrackManager(Config::MotionModel motion_model = Config::MOTION_MODEL);
+    void update(const ConsumerResult& result, TrackTable& tracks);
+    // 取走本帧新排定的动作（尚未到期），交给 ActuationDispatcher 按时触发
+    std::vector<PendingAction> takeScheduledActions();
+    // 最近一次 update 中退出并被删除的轨迹（unique_id），逐目标统计据此结算
+    const std::vector<int>& retiredTracks() const { return m_retired; }
+    // 关闭逐目标的控制台日志（批处理模式下多个数据集同时运行）
+    void setVerbose(bool verbose) { m_verbose = verbose; }
 
 private:
-    // [核心修改] 更新成员变量以反映双通道逻辑
+    // 每条车道的计数器与关联缓冲区，跨帧复用以避免每帧分配；各车道互不共享，可并行处理
+    struct LaneState {
+        int next_number = 0;  // 下一个分配编号
+        int exit_counter = 0;
+        GatedAssociator associator;
+        std::vector<Detection> detections;
+        std::vector<cv::Point2f> predicted_positions;
+        std::vector<cv::Point2f> detection_positions;
+        std::vector<int> assignment;
+        std::vector<uint8_t> track_matched;
+        std::vector<uint8_t> detection_matched;
+        std::vector<float> gate_radii;
+        std::vector<float> measurement_x, measurement_y, measurement_w, measurement_h;
+    };
+
+    // 预测、关联与状态更新：只改写本车道分区内的行，不增删行
+    void associate_lane(int lane, const RuntimeConfig::Snapshot& config, TrackTable& tracks, float dt);
+    // 删除退出的轨迹、为未匹配的检测建新轨迹：改变表结构，按车道顺序串行执行
+    void retire_and_spawn(int lane, const RuntimeConfig::Snapshot& config, TrackTable& tracks);
+    // 按最后观测位置与滤波速度外推到执行器直线，返回应触发的时刻（已扣除执行机构提前量）；
+    // 已越过直线时返回观测时刻（立即触发），没有直线或预测不可信时为观测时刻 + action_delay_ms
+    std::chrono::steady_clock::time_point arrival_time(const Config::Lane& lane_config, const RuntimeConfig::Snapshot& config,
+                                                       const TrackTable::Columns& c, int index) const;
+
     int m_next_unique_id = 0;
-    int m_next_number_A; // 通道A的下一个分配编号
-    int m_next_number_B; // 通道B的下一个分配编号
     int m_color_index = 0;
     std::vector<cv::Scalar> m_colors;
 
-    int m_exit_counter_A = 0;
-    int m_exit_counter_B = 0;
-
     std::vector<PendingAction> m_pending_actions;
+    std::vector<int> m_retired;
+
+    Config::MotionModel m_motion_model;
+    bool m_verbose = true;
+    int m_last_frame_idx = -1;
+    CaptureTime m_capture_time{};
+    float m_frame_period_s = 1.0f / Config::VIDEO_FPS; // 速度列单位为像素/帧，换算为像素/秒时使用
+
+    std::vector<LaneState> m_lanes;
 };
 
 #endif //TRACKMANAGER_H
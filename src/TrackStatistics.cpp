@@ -0,0 +1,125 @@
+#include "TrackStatistics.h"
+#include "config/Configuration.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace TrackStatistics {
+    void Accumulator::update(const TrackTable& tracks, const std::vector<int>& retired, int frame_idx, double seconds) {
+        const TrackTable::Columns& c = tracks.columns();
+        for (int i = 0; i < tracks.size(); ++i) {
+            if (c.missed_frames[i] != 0) continue;
+            auto [it, inserted] = m_live.try_emplace(c.unique_id[i]);
+            if (inserted) m_tracks_seen++;
+            it->second.assigned_number = c.assigned_number[i];
+            observe(it->second, {frame_idx, seconds, c.centroid_x[i], c.centroid_y[i]});
+        }
+        for (int unique_id : retired) {
+            auto it = m_live.find(unique_id);
+            // 统计开始前已存在、此后未再被检测到的轨迹没有记录
+            if (it == m_live.end()) continue;
+            finish(it->first, it->second);
+            m_live.erase(it);
+        }
+    }
+
+    void Accumulator::finish_all() {
+        // 按 unique_id 顺序结算，输出与轨迹创建顺序一致
+        std::vector<int> ids;
+        ids.reserve(m_live.size());
+        for (const auto& entry : m_live) ids.push_back(entry.first);
+        std::sort(ids.begin(), ids.end());
+        for (int unique_id : ids) finish(unique_id, m_live.at(unique_id));
+        m_live.clear();
+    }
+
+    // 第 n 个观测先进入尾部环形缓冲区，被第 n + TAIL 个观测挤出时才确定不属于尾部、并入累计量
+    void Accumulator::observe(Track& track, const Sample& sample) {
+        const int n = track.observations++;
+        if (TAIL == 0) {
+            commit(track, n, sample);
+            return;
+        }
+        Sample& slot = track.tail[n % track.tail.size()];
+        if (n >= TAIL) commit(track, n - TAIL, slot);
+        slot = sample;
+    }
+
+    void Accumulator::commit(Track& track, int index, const Sample& sample) {
+        if (index < Config::TRIM_FRAMES_FROM_ENDS) return; // 头部裁剪
+        if (track.kept == 0) {
+            track.first = sample;
+        } else {
+            const double step = std::hypot(sample.x - track.last.x, sample.y - track.last.y);
+            const double dt = sample.seconds - track.last.seconds;
+            track.path_length += step;
+            if (dt > 0) track.max_speed = std::max(track.max_speed, step / dt);
+        }
+        track.last = sample;
+        track.kept++;
+    }
+
+    void Accumulator::finish(int unique_id, const Track& track) {
+        if (track.observations <= Config::MIN_TRACK_LENGTH_FOR_STATS) return;
+        if (track.observations < 2 * Config::TRIM_FRAMES_FROM_ENDS + 2) return;
+        const double duration = track.last.seconds - track.first.seconds;
+        const double distance = std::hypot(track.last.x - track.first.x, track.last.y - track.first.y);
+        Summary summary;
+        summary.assigned_number = track.assigned_number;
+        summary.frame_count = track.kept;
+        summary.speed_pixels_per_sec = duration > 0 ? distance / duration : 0.0;
+        summary.unique_id = unique_id;
+        summary.first_frame = track.first.frame;
+        summary.last_frame = track.last.frame;
+        summary.path_length_pixels = track.path_length;
+        summary.path_speed_pixels_per_sec = duration > 0 ? track.path_length / duration : 0.0;
+        summary.max_speed_pixels_per_sec = track.max_speed;
+        m_summaries.push_back(summary);
+    }
+
+    void print(const std::vector<Summary>& summaries) {
+        std::cout << "\n--- Instance Statistics Summary ---" << std::endl;
+        std::cout << std::left << std::setw(20) << "assigned_number"
+                  << std::setw(15) << "frame_count"
+                  << std::setw(24) << "speed_pixels_per_sec"
+                  << std::setw(12) << "unique_id"
+                  << std::setw(20) << "path_length_pixels"
+                  << "max_speed_pixels_per_sec" << std::endl;
+        for (const auto& summary : summaries) {
+            std::cout << std::left << std::setw(20) << summary.assigned_number
+                      << std::setw(15) << summary.frame_count
+                      << std::fixed << std::setprecision(2) << std::setw(24) << summary.speed_pixels_per_sec
+                      << std::setw(12) << summary.unique_id
+                      << std::setw(20) << summary.path_length_pixels
+                      << summary.max_speed_pixels_per_sec << std::endl;
+        }
+        std::cout << std::defaultfloat;
+    }
+
+    bool write_csv(const std::vector<Summary>& summaries, const std::string& csv_path) {
+        std::filesystem::create_directories(std::filesystem::path(csv_path).parent_path());
+        std::ofstream csv_file(csv_path);
+        if (!csv_file.is_open()) {
+            std::cerr << "[Error] Could not open file for writing: " << csv_path << std::endl;
+            return false;
+        }
+        csv_file << "assigned_number,frame_count,speed_pixels_per_sec,unique_id,first_frame,last_frame,"
+                    "path_length_pixels,path_speed_pixels_per_sec,max_speed_pixels_per_sec\n";
+        csv_file << std::fixed << std::setprecision(2);
+        for (const auto& summary : summaries) {
+            csv_file << summary.assigned_number << ","
+                     << summary.frame_count << ","
+                     << summary.speed_pixels_per_sec << ","
+                     << summary.unique_id << ","
+                     << summary.first_frame << ","
+                     << summary.last_frame << ","
+                     << summary.path_length_pixels << ","
+                     << summary.path_speed_pixels_per_sec << ","
+                     << summary.max_speed_pixels_per_sec << "\n";
+        }
+        return true;
+    }
+}
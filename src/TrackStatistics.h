@@ -0,0 +1,72 @@
+#ifndef TRACK_STATISTICS_H
+#define TRACK_STATISTICS_H
+
+#include "config/Configuration.h"
+#include "utils/TrackTable.h"
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 逐目标汇总：每条轨迹（unique_id）去掉首尾 TRIM_FRAMES_FROM_ENDS 个观测后计算速度与路程
+namespace TrackStatistics {
+    struct Summary {
+        int assigned_number;
+        int frame_count;             // 去掉首尾后的观测数
+        double speed_pixels_per_sec; // 首尾位移 / 时长
+        int unique_id;
+        int first_frame, last_frame;
+        double path_length_pixels;        // 相邻观测的距离之和
+        double path_speed_pixels_per_sec; // 路程 / 时长
+        double max_speed_pixels_per_sec;  // 相邻观测间的最大速度
+    };
+
+    // 在线累计：每条存活轨迹只保留最近 TRIM_FRAMES_FROM_ENDS 个观测的环形缓冲区（尾部待裁掉的部分），
+    // 更早的观测到达时即并入首尾位置、路程与最大速度；轨迹被 TrackManager 删除时结算为一条 Summary。
+    // 内存只与同时存活的轨迹数有关，与会话时长无关。只由跟踪线程调用。
+    class Accumulator {
+    public:
+        // 加入本帧被检测到的轨迹（丢失中的不计），再结算本帧退出的轨迹；seconds 为本帧的时间
+        void update(const TrackTable& tracks, const std::vector<int>& retired, int frame_idx, double seconds);
+        // 会话结束：结算所有仍存活的轨迹
+        void finish_all();
+
+        // 按退出顺序排列
+        const std::vector<Summary>& summaries() const { return m_summaries; }
+        int tracks_seen() const { return m_tracks_seen; }
+        size_t live_tracks() const { return m_live.size(); }
+
+    private:
+        static constexpr int TAIL = Config::TRIM_FRAMES_FROM_ENDS;
+
+        struct Sample {
+            int frame;
+            double seconds;
+            float x, y;
+        };
+        struct Track {
+            int assigned_number = 0;
+            int observations = 0;
+            std::array<Sample, (TAIL > 0 ? TAIL : 1)> tail{}; // 第 n 个观测在 tail[n % TAIL]
+            // 已越过尾部窗口、且不在头部裁剪范围内的观测的累计量
+            int kept = 0;
+            Sample first{}, last{};
+            double path_length = 0.0;
+            double max_speed = 0.0;
+        };
+
+        void observe(Track& track, const Sample& sample);
+        void commit(Track& track, int index, const Sample& sample);
+        void finish(int unique_id, const Track& track);
+
+        std::unordered_map<int, Track> m_live; // unique_id -> 存活轨迹
+        std::vector<Summary> m_summaries;
+        int m_tracks_seen = 0;
+    };
+
+    void print(const std::vector<Summary>& summaries);
+    // 写出失败返回 false
+    bool write_csv(const std::vector<Summary>& summaries, const std::string& csv_path);
+}
+
+#endif //TRACK_STATISTICS_H
@@ -0,0 +1,106 @@
+#include "TrajectoryWriter.h"
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char FILE_MAGIC[8] = {'A', 'P', 'L', 'T', 'R', 'J', '0', '1'};
+    constexpr uint32_t FILE_VERSION = 1;
+    constexpr uint32_t COLUMN_COUNT = 7;
+    constexpr uint32_t BLOCK_MAGIC = 0x4B4C4254; // "TBLK"
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t column_count;
+    };
+    static_assert(sizeof(FileHeader) == 16, "FileHeader layout");
+
+    struct BlockHeader {
+        uint32_t magic;
+        uint32_t rows;
+        uint64_t reserved;
+    };
+    static_assert(sizeof(BlockHeader) == 16, "BlockHeader layout");
+}
+
+TrajectoryWriter::TrajectoryWriter(const std::string& path, size_t block_rows)
+    : m_path(path), m_block_rows(block_rows ? block_rows : 1) {
+    const fs::path parent = fs::path(path).parent_path();
+    if (!parent.empty()) fs::create_directories(parent);
+    m_out.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_out.is_open()) throw std::runtime_error("Could not open trajectory file for writing: " + path);
+    FileHeader header{};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FILE_VERSION;
+    header.column_count = COLUMN_COUNT;
+    m_out.write((const char*)&header, sizeof(header));
+    m_bytes = sizeof(header);
+
+    m_timestamp_ns.reserve(m_block_rows);
+    for (auto* column : {&m_frame, &m_unique_id, &m_assigned_number, &m_lane}) column->reserve(m_block_rows);
+    m_x.reserve(m_block_rows);
+    m_y.reserve(m_block_rows);
+}
+
+TrajectoryWriter::~TrajectoryWriter() {
+    close();
+}
+
+void TrajectoryWriter::append(const TrackTable& tracks, int frame_idx, int64_t timestamp_ns) {
+    if (m_failed) return;
+    const TrackTable::Columns& c = tracks.columns();
+    for (int lane = 0; lane < tracks.partition_count(); ++lane) {
+        for (int i = tracks.begin(lane); i < tracks.end(lane); ++i) {
+            if (c.missed_frames[i] != 0) continue;
+            m_timestamp_ns.push_back(timestamp_ns);
+            m_frame.push_back(frame_idx);
+            m_unique_id.push_back(c.unique_id[i]);
+            m_assigned_number.push_back(c.assigned_number[i]);
+            m_lane.push_back(lane);
+            m_x.push_back(c.centroid_x[i]);
+            m_y.push_back(c.centroid_y[i]);
+            if (m_frame.size() == m_block_rows) flush_block();
+        }
+    }
+}
+
+void TrajectoryWriter::flush_block() {
+    const size_t rows = m_frame.size();
+    if (rows == 0 || m_failed) return;
+    const BlockHeader header{BLOCK_MAGIC, (uint32_t)rows, 0};
+    m_out.write((const char*)&header, sizeof(header));
+    auto put = [this](const auto& column) {
+        m_out.write((const char*)column.data(), (std::streamsize)(column.size() * sizeof(column[0])));
+    };
+    put(m_timestamp_ns);
+    put(m_frame);
+    put(m_unique_id);
+    put(m_assigned_number);
+    put(m_lane);
+    put(m_x);
+    put(m_y);
+    // 每块交给操作系统，进程异常退出时已写出的块不丢失
+    m_out.flush();
+    if (!m_out) {
+        std::cerr << "[Error] Failed to write trajectory file: " << m_path << " (trajectory output stopped)" << std::endl;
+        m_failed = true;
+        return;
+    }
+    m_rows += rows;
+    m_bytes += sizeof(header) + rows * (sizeof(int64_t) + 4 * sizeof(int32_t) + 2 * sizeof(float));
+
+    m_timestamp_ns.clear();
+    for (auto* column : {&m_frame, &m_unique_id, &m_assigned_number, &m_lane}) column->clear();
+    m_x.clear();
+    m_y.clear();
+}
+
+void TrajectoryWriter::close() {
+    if (!m_out.is_open()) return;
+    flush_block();
+    m_out.close();
+}
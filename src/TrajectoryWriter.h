@@ -0,0 +1,48 @@
+#ifndef TRAJECTORY_WRITER_H
+#define TRAJECTORY_WRITER_H
+
+#include "config/Configuration.h"
+#include "utils/TrackTable.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// 完整轨迹文件：每帧每个被检测到的目标一行，按列分块追加写入（小端）：
+//   文件头 16 字节：magic "APLTRJ01"、版本、列数
+//   逐块：块头 16 字节（magic "TBLK"、行数 n、保留 8 字节），其后依次为各列的 n 个值：
+//     timestamp_ns (int64) | frame (int32) | unique_id (int32) | assigned_number (int32) | lane (int32) | x (float32) | y (float32)
+// 块内同一列连续存放，读取方可整列映射 / 向量化处理；文件只追加不回写，写入中断时丢失的只是最后一个未满的块。
+// 失败时构造函数抛出 std::runtime_error；写盘失败打印一次错误，此后不再写入。只由跟踪线程调用。
+class TrajectoryWriter {
+public:
+    explicit TrajectoryWriter(const std::string& path, size_t block_rows = Config::TRAJECTORY_BLOCK_ROWS);
+    ~TrajectoryWriter();
+    TrajectoryWriter(const TrajectoryWriter&) = delete;
+    TrajectoryWriter& operator=(const TrajectoryWriter&) = delete;
+
+    // 追加本帧被检测到的轨迹（丢失中的不计）；攒满一块时写盘
+    void append(const TrackTable& tracks, int frame_idx, int64_t timestamp_ns);
+    // 写出未满的块并关闭；析构时自动调用
+    void close();
+
+    uint64_t rows() const { return m_rows; }
+    uint64_t bytes() const { return m_bytes; }
+
+private:
+    void flush_block();
+
+    std::string m_path;
+    std::ofstream m_out;
+    size_t m_block_rows;
+    uint64_t m_rows = 0;
+    uint64_t m_bytes = 0;
+    bool m_failed = false;
+
+    // 当前块的各列
+    std::vector<int64_t> m_timestamp_ns;
+    std::vector<int32_t> m_frame, m_unique_id, m_assigned_number, m_lane;
+    std::vector<float> m_x, m_y;
+};
+
+#endif //TRAJECTORY_WRITER_H
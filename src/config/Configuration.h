@@ -6,41 +6,124 @@
 #include <vector>
 #include <set>
 
+// 本文件中的取值为编译期默认值。标注“可由 SETTINGS_FILE 覆盖”的参数在启动时从配置文件读入，
+// 运行期间修改文件会热加载（见 RuntimeConfig），流水线各阶段只读取随帧传递的不可变快照。
 namespace Config {
+    // 一条输送线（车道）：画面中的一个 ROI，以及该线上的编号区间、分拣序列和执行器代码
+    struct Lane {
+        std::string name;           // 显示名，如 "A"
+        cv::Rect roi;
+        int start_number;           // 编号区间 [start_number, end_number]，用尽后回绕
+        int end_number;
+        std::set<int> sort_sequence; // 需要触发执行器的编号
+        char action_code;           // 发给执行器的字符
+        // 执行器所在直线（图像坐标，两点 x1, y1, x2, y2，可在画面外）：按轨迹最后观测位置与速度
+        // 预测到达该线的时刻并提前 actuator_lead_ms 触发；全 0 表示未标定，退回“最后观测 + action_delay_ms”
+        cv::Vec4f actuator_line = {0, 0, 0, 0};
+        int actuator_lead_ms = 0;   // 执行机构自身的动作时间（推杆伸出等）
+
+        bool has_actuator_line() const { return actuator_line[0] != actuator_line[2] || actuator_line[1] != actuator_line[3]; }
+    };
+
     // =================================================================
     // 1. 全局模式开关
     // =================================================================
-    // 设置为 true 则使用实时相机模式，设置为 false 则使用本地数据集模式
+    // 设置为 true 则使用实时相机模式，设置为 false 则使用本地数据集模式（可由 SETTINGS_FILE 的 use_live_camera 覆盖）
     // 注意：如果使用本地数据集模式，则需要确保 DATASETS_PATH 中的路径正确
     //       并且 DATASET_INDICES_TO_RUN 中的索引在 DATASETS_PATH 范围内
     constexpr bool USE_LIVE_CAMERA = false;
+    // 运行期配置文件（YAML / JSON，格式见 config/settings.example.yml），不存在时全部使用本文件的默认值
+    const std::string SETTINGS_FILE = "config/settings.yml";
+    // 热加载轮询间隔：文件修改时间变化后重新解析，校验通过才在帧间替换快照
+    constexpr int SETTINGS_POLL_MS = 500;
 
     // =================================================================
     // 2. 通用配置
     // =================================================================
+    // 以下三项可由 SETTINGS_FILE 覆盖（min_area / max_distance / max_missed_frames）
     constexpr int MIN_AREA_THRESHOLD = 2750;
     constexpr float MAX_DISTANCE_FOR_TRACKING = 150.0f;
     constexpr int MAX_MISSED_FRAMES = 5;
+    // 运动模型：VelocityBlend 为“质心 + 速度”预测、0.5 系数平滑速度；
+    // Kalman 为匀速卡尔曼滤波，遮挡期间继续外推位置，关联时使用马氏距离门限
+    enum class MotionModel { VelocityBlend, Kalman };
+    constexpr MotionModel MOTION_MODEL = MotionModel::VelocityBlend;
+    namespace Kalman {
+        constexpr float PROCESS_NOISE = 4.0f;               // 加速度噪声方差（像素²/帧⁴）
+        constexpr float MEASUREMENT_NOISE = 9.0f;           // 质心测量噪声方差（像素²）
+        constexpr float INITIAL_VELOCITY_VARIANCE = 100.0f; // 新轨迹速度的初始方差（像素²/帧²）
+        constexpr bool TRACK_SIZE = true;                   // 状态包含 bbox 宽高，并参与门限
+        constexpr float SIZE_PROCESS_NOISE = 4.0f;
+        constexpr float SIZE_MEASUREMENT_NOISE = 25.0f;
+        constexpr float GATE_CHI2_POSITION = 9.21f;         // 2 自由度 99% 分位
+        constexpr float GATE_CHI2_WITH_SIZE = 13.28f;       // 4 自由度 99% 分位
+        constexpr float MAX_GATE_RADIUS = 2.0f * MAX_DISTANCE_FOR_TRACKING; // 搜索半径上限（像素）
+    }
     constexpr float VIDEO_FPS = 30.0f;
     const cv::Size DISPLAY_SIZE = {1280, 720};
-    constexpr int ACTION_DELAY_MS = 500;
+    // 显示刷新率上限（帧/秒）：跟踪线程最多按该频率把最新快照交给渲染线程，其余帧不绘制；0 表示逐帧渲染
+    // 数据集模式录制视频时仍逐帧渲染写入视频，只有窗口刷新受该频率限制
+    constexpr float DISPLAY_FPS = 30.0f;
+    // 无界面构建（CMake -DHEADLESS=ON 定义 APPLE_TRACKER_HEADLESS）：不链接 highgui，不启动渲染 / 编码线程，不录制视频
+#ifdef APPLE_TRACKER_HEADLESS
+    constexpr bool DISPLAY_ENABLED = false;
+#else
+    constexpr bool DISPLAY_ENABLED = true;
+#endif
+    constexpr int ACTION_DELAY_MS = 500; // 可由 SETTINGS_FILE 的 action_delay_ms 覆盖
+    // 执行器调度线程先睡眠到截止时间前该时长，再自旋到截止时间（微秒）
+    constexpr int ACTUATION_SPIN_US = 1000;
+    // 执行器串口（可由 SETTINGS_FILE 的 actuator_port / actuator_baud 覆盖）：
+    // "loopback" 为进程内模拟执行器，"pty" 经伪终端回环（仅 POSIX），用于脱离硬件测试
+#ifdef _WIN32
+    const std::string ACTUATOR_PORT = "COM3";
+#else
+    const std::string ACTUATOR_PORT = "/dev/ttyUSB0";
+#endif
+    constexpr int ACTUATOR_BAUD = 9600;
+    constexpr int ACTUATOR_WRITE_TIMEOUT_MS = 50;
+    // 发送队列容量（命令）：满时新命令被丢弃并计数，send() 从不阻塞
+    constexpr size_t ACTUATOR_QUEUE_CAPACITY = 64;
+    constexpr size_t ACTUATOR_MAX_BATCH = 16;       // 单次 write 合并的最多命令数
+    constexpr int ACTUATOR_RECONNECT_MIN_MS = 100;  // 重连退避：从该值起每次翻倍
+    constexpr int ACTUATOR_RECONNECT_MAX_MS = 5000;
+    // 断线期间积压超过该时长（毫秒）的命令在重连后丢弃
+    constexpr int ACTUATOR_STALE_MS = 200;
+    // 预测到达时间超过该值（秒）视为停线或速度估计失效，退回固定延时
+    constexpr float MAX_ARRIVAL_SECONDS = 10.0f;
+    // 调度线程使用实时优先级（Windows TIME_CRITICAL / POSIX SCHED_FIFO），权限不足时退回普通优先级
+    constexpr bool ACTUATION_REALTIME_PRIORITY = true;
+    // 重排缓冲区前瞻窗口（帧）：队首缺失超过该距离即跳过，避免丢帧卡死流水线
+    constexpr int REORDER_WINDOW = 64;
+    // 输入队列容量（帧）：数据集模式满则阻塞生产者，实时模式满则丢弃最旧帧
+    constexpr size_t INPUT_QUEUE_CAPACITY = 16;
+    // 显示/录制队列容量（帧）：实时模式满则跳过显示，不拖慢跟踪（按 DISPLAY_FPS 抽样后通常不会满）
+    constexpr size_t VISUAL_QUEUE_CAPACITY = 4;
+    // 视频编码队列容量（帧）：满时按 Settings::encoder_overflow 阻塞或丢帧
+    constexpr size_t ENCODE_QUEUE_CAPACITY = 8;
+    // 逐段延迟统计（采集 -> 各阶段 -> 执行器）：每隔 TRACE_REPORT_INTERVAL_MS 打印区间 p50 / p99 / max（0 为只在退出时打印）
+    constexpr bool TRACE_ENABLED = true;
+    constexpr int TRACE_REPORT_INTERVAL_MS = 10000;
+    // 非空时保留逐次事件并在退出时导出 Chrome trace JSON（如 "output/trace.json"）
+    const std::string TRACE_CHROME_PATH = "";
+    constexpr size_t TRACE_MAX_EVENTS_PER_THREAD = 1 << 20; // 每线程事件上限（每条 24 字节，按 4096 条分块分配）
 
-#if USE_LIVE_CAMERA
     // =================================================================
     // 3.A 实时相机模式配置
     // =================================================================
-    const cv::Rect ROI_A = {100, 50, 900, 250};
-    const cv::Rect ROI_B = {100, 400, 900, 250};
-    const cv::Scalar LOWER_HSV = {15, 100, 100};
-    const cv::Scalar UPPER_HSV = {35, 255, 255};
-    const cv::Point2f INITIAL_MOVEMENT = {20.0f, 0.0f};
-    constexpr int START_NUMBER_A = 1;
-    constexpr int START_NUMBER_B = 1001;
-    namespace SortingLogic {
-        const std::set<int> SEQUENCE_A = {1, 3, 5};
-        const std::set<int> SEQUENCE_B = {1002, 1004};
+    // 两种模式各自的 HSV 阈值、初始运动方向与车道表默认值，按运行期的 use_live_camera 选用；
+    // 均可由 SETTINGS_FILE 覆盖（lower_hsv / upper_hsv / initial_movement / lanes）
+    namespace Live {
+        const cv::Scalar LOWER_HSV = {15, 100, 100};
+        const cv::Scalar UPPER_HSV = {35, 255, 255};
+        const cv::Point2f INITIAL_MOVEMENT = {20.0f, 0.0f};
+        // 内置车道表（配置文件未给出 lanes 时使用）
+        const std::vector<Lane> DEFAULT_LANES = {
+            {"A", {100, 50, 900, 250}, 1, 1000, {1, 3, 5}, 'A'},
+            {"B", {100, 400, 900, 250}, 1001, 2000, {1002, 1004}, 'B'},
+        };
     }
-#else
+
     // =================================================================
     // 3.B 本地数据集模式配置
     // =================================================================
@@ -76,22 +159,59 @@ namespace Config {
         "C:/Users/JmZha/VSCode_Project/Datasets/Apple/recording_20250107-185322"  // 28
     };
     const std::vector<int> DATASET_INDICES_TO_RUN = {0, 5, 7, 11, 14, 15, 17, 19, 20, 23, 25};
-    const cv::Rect ROI_A = {820, 100, 200, 900};
-    const cv::Rect ROI_B = {1130, 100, 200, 900};
-    const cv::Scalar LOWER_HSV = {10, 40, 40};
-    const cv::Scalar UPPER_HSV = {40, 255, 255};
-    const cv::Point2f INITIAL_MOVEMENT = {0.0f, -20.0f};
-    constexpr int START_NUMBER_A = 1;
-    constexpr int START_NUMBER_B = 1001;
-    namespace SortingLogic {
-        const std::set<int> SEQUENCE_A = {1, 8};
-        const std::set<int> SEQUENCE_B = {1001, 1002};
+    // 无界面批处理（--batch）：所有数据集共享一个工作窃取线程池，0 表示使用全部硬件线程
+    constexpr unsigned int BATCH_THREADS = 0;
+    // 每个数据集同时在途（已提交读图 / 分割、尚未跟踪）的帧数上限
+    constexpr int BATCH_FRAMES_IN_FLIGHT = 8;
+    const std::string BATCH_REPORT_FILENAME = "batch_report.csv"; // 写在 output/ 下
+    namespace Dataset {
+        const cv::Scalar LOWER_HSV = {10, 40, 40};
+        const cv::Scalar UPPER_HSV = {40, 255, 255};
+        const cv::Point2f INITIAL_MOVEMENT = {0.0f, -20.0f};
+        // 内置车道表（配置文件未给出 lanes 时使用）
+        const std::vector<Lane> DEFAULT_LANES = {
+            {"A", {820, 100, 200, 900}, 1, 1000, {1, 8}, 'A'},
+            {"B", {1130, 100, 200, 900}, 1001, 2000, {1001, 1002}, 'B'},
+        };
     }
-#endif
+
+    // 单帧轨迹数 + 检测数达到该值时才把各车道的跟踪分发到线程池，否则逐车道串行（任务调度开销更大）
+    constexpr int PARALLEL_LANE_MIN_WORK = 64;
 
     // =================================================================
     // 4. 其他通用参数
     // =================================================================
+    // HSV 阈值实现：OpenCV 为 cvtColor + inRange（UMat，可走 OpenCL）；Fused 为单遍 SIMD 融合核；
+    // LookupTable 为加载配置时生成的 2^24 位 BGR 查找表（按阈值缓存到 HSV_LUT_CACHE_DIR，阈值热切换时在后台重建）。三者结果逐位一致
+    enum class HsvThresholdMode { OpenCV, Fused, LookupTable };
+    constexpr HsvThresholdMode HSV_THRESHOLD_MODE = HsvThresholdMode::Fused;
+    const std::string HSV_LUT_CACHE_DIR = "cache";
+    // 是否额外生成整帧 CV_32S 标签图（连通域分析本身逐 ROI 进行，目前没有下游使用整帧标签）
+    constexpr bool KEEP_FULL_FRAME_LABELS = false;
+    // 相机帧格式：BgraZeroCopy 把 k4a 的 BGRA 缓冲区以引用计数视图直接交给流水线，分割只读取 ROI；
+    // Bgr 为逐帧整幅 cvtColor(BGRA -> BGR) 的旧路径
+    enum class CaptureFormat { Bgr, BgraZeroCopy };
+    constexpr CaptureFormat CAPTURE_FORMAT = CaptureFormat::BgraZeroCopy;
+    // 非空时实时模式改用该目录下的图片模拟相机（按 VIDEO_FPS 出帧），无需连接传感器
+    const std::string FAKE_CAMERA_PATH = "";
+    // 录制文件（见 FrameRecording.h）：帧索引 + 时间戳 + 原始 / ROI 裁剪 / 轻压缩负载，回放时 mmap 零拷贝读取。
+    // 数据集路径与 FAKE_CAMERA_PATH 均可直接指向录制文件；--convert 把图片目录转换为录制文件
+    const std::string RECORDING_EXTENSION = ".arec";
+    // Raw 为整帧原始像素（零拷贝）；RoiCrop 只保存各车道 ROI 的外接矩形；Png 为快速压缩级别的无损 PNG
+    enum class RecordingPayload { Raw, RoiCrop, Png };
+    constexpr int RECORDING_PNG_COMPRESSION = 1; // 0-9，1 为最快
+    // 实时模式是否把采集到的帧录制为 output/live_session.arec（后台线程写盘，跟不上时丢帧并计数）
+    constexpr bool RECORD_LIVE_SESSION = false;
+    constexpr RecordingPayload LIVE_RECORDING_PAYLOAD = RecordingPayload::RoiCrop;
+    constexpr size_t RECORD_QUEUE_CAPACITY = 8; // 帧（相机零拷贝缓冲区在写盘前一直被占用）
+    // 回放录制文件时从该时间戳（秒）开始，按帧索引直接定位
+    constexpr double REPLAY_START_SECONDS = 0.0;
+    // 数据集模式的解码线程数（decode 阶段按帧并行，重排缓冲区恢复顺序）。
+    // 与分割 / 标记共享 hardware_concurrency 的核心预算：0 表示约三分之一，其余核心由后两级平分
+    constexpr unsigned int DECODE_THREADS = 0;
+    // 有损处理模式：JPEG 数据集按 1/N 尺度解码（1 / 2 / 4 / 8，libjpeg DCT 缩放）再放大回原尺寸。
+    // 放大后的低分辨率帧进入分割、标记、跟踪与统计，检测结果和速度都与整帧解码不同；只用于快速粗看数据集，非 1 时启动会提示
+    constexpr int LOSSY_JPEG_DECODE_SCALE = 1;
     constexpr int MORPH_KERNEL_SIZE = 5;
     constexpr int MORPH_ITERATIONS = 1;
     const int FONT_FACE = cv::FONT_HERSHEY_SIMPLEX;
@@ -108,5 +228,9 @@ namespace Config {
     const std::string OUTPUT_VIDEO_FILENAME = "tracked_video.mp4";
     const int VIDEO_CODEC = cv::VideoWriter::fourcc('m', 'p', '4', 'v');
     const std::string OUTPUT_CSV_FILENAME = "instance_summary.csv";
+    // 完整轨迹（每帧每个被检测到的目标一行）流式写入 output/<数据集名>/ 下的列式二进制文件，格式见 TrajectoryWriter.h
+    constexpr bool SAVE_TRAJECTORIES = true;
+    const std::string TRAJECTORY_FILENAME = "trajectories.trj";
+    constexpr size_t TRAJECTORY_BLOCK_ROWS = 4096; // 每块行数：攒满一块才写盘，跟踪线程不逐帧写文件
 }
 #endif
\ No newline at end of file
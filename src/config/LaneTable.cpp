@@ -0,0 +1,70 @@
+#include "LaneTable.h"
+#include <climits>
+#include <iostream>
+#include <stdexcept>
+
+namespace Lanes {
+    namespace {
+        Config::Lane parse_lane(const cv::FileNode& node, size_t index) {
+            Config::Lane lane;
+            lane.name = node["name"].empty() ? std::to_string(index) : (std::string)node["name"];
+            std::vector<int> roi;
+            node["roi"] >> roi;
+            if (roi.size() != 4) throw std::runtime_error("Lane '" + lane.name + "': roi must be [x, y, width, height]");
+            lane.roi = cv::Rect(roi[0], roi[1], roi[2], roi[3]);
+            lane.start_number = (int)node["start_number"];
+            lane.end_number = node["end_number"].empty() ? INT_MAX : (int)node["end_number"];
+            std::vector<int> sequence;
+            node["sort_sequence"] >> sequence;
+            lane.sort_sequence.insert(sequence.begin(), sequence.end());
+            const std::string code = node["action_code"].empty() ? lane.name : (std::string)node["action_code"];
+            if (code.size() != 1) throw std::runtime_error("Lane '" + lane.name + "': action_code must be a single character");
+            lane.action_code = code[0];
+            if (!node["actuator_line"].empty()) {
+                std::vector<float> line;
+                node["actuator_line"] >> line;
+                if (line.size() != 4) throw std::runtime_error("Lane '" + lane.name + "': actuator_line must be [x1, y1, x2, y2]");
+                lane.actuator_line = cv::Vec4f(line[0], line[1], line[2], line[3]);
+            }
+            if (!node["actuator_lead_ms"].empty()) lane.actuator_lead_ms = (int)node["actuator_lead_ms"];
+            return lane;
+        }
+    }
+
+    std::vector<Config::Lane> parse(const cv::FileNode& nodes) {
+        if (!nodes.isSeq()) throw std::runtime_error("'lanes' must be a sequence");
+        std::vector<Config::Lane> lanes;
+        for (size_t i = 0; i < nodes.size(); ++i) lanes.push_back(parse_lane(nodes[(int)i], i));
+        return lanes;
+    }
+
+    void validate(const std::vector<Config::Lane>& lanes) {
+        if (lanes.empty()) throw std::runtime_error("Lane table is empty");
+        for (size_t i = 0; i < lanes.size(); ++i) {
+            const Config::Lane& lane = lanes[i];
+            const std::string where = "Lane '" + lane.name + "': ";
+            if (lane.roi.width <= 0 || lane.roi.height <= 0 || lane.roi.x < 0 || lane.roi.y < 0) {
+                throw std::runtime_error(where + "invalid ROI");
+            }
+            if (lane.start_number > lane.end_number) {
+                throw std::runtime_error(where + "start_number is greater than end_number");
+            }
+            if (lane.actuator_lead_ms < 0) throw std::runtime_error(where + "actuator_lead_ms must not be negative");
+            if (!lane.has_actuator_line() && !lane.sort_sequence.empty()) {
+                std::cout << "[Info] " << where << "no actuator_line, actions fire a fixed delay after the last observation." << std::endl;
+            }
+            for (size_t j = 0; j < i; ++j) {
+                const Config::Lane& other = lanes[j];
+                if (other.name == lane.name) throw std::runtime_error(where + "duplicate name");
+                if (lane.start_number <= other.end_number && other.start_number <= lane.end_number) {
+                    std::cout << "[Warning] " << where << "numbering range overlaps lane '" << other.name << "'." << std::endl;
+                }
+            }
+            for (int number : lane.sort_sequence) {
+                if (number < lane.start_number || number > lane.end_number) {
+                    std::cout << "[Warning] " << where << "sort number " << number << " is outside its numbering range." << std::endl;
+                }
+            }
+        }
+    }
+}
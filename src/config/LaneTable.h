@@ -0,0 +1,16 @@
+#ifndef LANETABLE_H
+#define LANETABLE_H
+
+#include "Configuration.h"
+#include <vector>
+
+// 车道表的解析与校验，由 RuntimeConfig 在读入配置文件时调用。
+// 车道下标即 Detection::roi_id 与 TrackTable 的分区号，运行期间车道数量与顺序保持不变。
+namespace Lanes {
+    // 解析配置文件中的 lanes 序列，格式错误时抛出 std::runtime_error
+    std::vector<Config::Lane> parse(const cv::FileNode& nodes);
+    // 校验 ROI、编号区间与重名，错误时抛出 std::runtime_error；可疑但可运行的配置只打印警告
+    void validate(const std::vector<Config::Lane>& lanes);
+}
+
+#endif //LANETABLE_H
@@ -0,0 +1,210 @@
+#include "RuntimeConfig.h"
+#include "LaneTable.h"
+#include <atomic>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+
+namespace RuntimeConfig {
+    namespace {
+        Snapshot defaults(bool live) {
+            Snapshot s;
+            s.use_live_camera = live;
+            s.datasets_path = Config::DATASETS_PATH;
+            s.dataset_indices = Config::DATASET_INDICES_TO_RUN;
+            s.lower_hsv = live ? Config::Live::LOWER_HSV : Config::Dataset::LOWER_HSV;
+            s.upper_hsv = live ? Config::Live::UPPER_HSV : Config::Dataset::UPPER_HSV;
+            s.initial_movement = live ? Config::Live::INITIAL_MOVEMENT : Config::Dataset::INITIAL_MOVEMENT;
+            s.lanes = live ? Config::Live::DEFAULT_LANES : Config::Dataset::DEFAULT_LANES;
+            return s;
+        }
+
+        template<typename T>
+        void read(const cv::FileNode& node, T& value) {
+            if (!node.empty()) node >> value;
+        }
+
+        void read_scalar(const cv::FileNode& node, const char* key, cv::Scalar& value) {
+            if (node.empty()) return;
+            std::vector<double> v;
+            node >> v;
+            if (v.size() != 3) throw std::runtime_error(std::string(key) + " must be [H, S, V]");
+            value = cv::Scalar(v[0], v[1], v[2]);
+        }
+
+        void read_point(const cv::FileNode& node, const char* key, cv::Point2f& value) {
+            if (node.empty()) return;
+            std::vector<float> v;
+            node >> v;
+            if (v.size() != 2) throw std::runtime_error(std::string(key) + " must be [x, y]");
+            value = cv::Point2f(v[0], v[1]);
+        }
+
+        void validate(const Snapshot& s) {
+            if (s.min_area < 0) throw std::runtime_error("min_area must not be negative");
+            if (s.max_distance <= 0.0f) throw std::runtime_error("max_distance must be positive");
+            if (s.max_missed_frames < 0) throw std::runtime_error("max_missed_frames must not be negative");
+            if (s.action_delay_ms < 0) throw std::runtime_error("action_delay_ms must not be negative");
+            if (s.actuator_baud <= 0) throw std::runtime_error("actuator_baud must be positive");
+            for (int c = 0; c < 3; ++c) {
+                if (s.lower_hsv[c] > s.upper_hsv[c]) {
+                    std::cout << "[Warning] lower_hsv[" << c << "] is above upper_hsv[" << c << "], nothing will be segmented." << std::endl;
+                }
+            }
+            Lanes::validate(s.lanes);
+        }
+
+        // running_mode 非空时（热加载）其余键按正在运行的模式取默认值：模式切换要重启才生效，
+        // 不能让文件里新写的 use_live_camera 把另一模式的阈值、初始速度和车道带进当前会话
+        Snapshot read_file(const std::string& path, std::optional<bool> running_mode = std::nullopt) {
+            cv::FileStorage fs(path, cv::FileStorage::READ);
+            if (!fs.isOpened()) throw std::runtime_error("Could not open settings file: " + path);
+
+            // 模式决定其余键的默认值，先读
+            int live = Config::USE_LIVE_CAMERA ? 1 : 0;
+            read(fs["use_live_camera"], live);
+            Snapshot s = defaults(running_mode.value_or(live != 0));
+            s.use_live_camera = live != 0;
+            read(fs["datasets_path"], s.datasets_path);
+            read(fs["dataset_indices"], s.dataset_indices);
+            read(fs["actuator_port"], s.actuator_port);
+            read(fs["actuator_baud"], s.actuator_baud);
+            read_scalar(fs["lower_hsv"], "lower_hsv", s.lower_hsv);
+            read_scalar(fs["upper_hsv"], "upper_hsv", s.upper_hsv);
+            read(fs["min_area"], s.min_area);
+            read(fs["max_distance"], s.max_distance);
+            read(fs["max_missed_frames"], s.max_missed_frames);
+            read(fs["action_delay_ms"], s.action_delay_ms);
+            read_point(fs["initial_movement"], "initial_movement", s.initial_movement);
+            if (!fs["lanes"].empty()) s.lanes = Lanes::parse(fs["lanes"]);
+            validate(s);
+            return s;
+        }
+
+        bool same_bounds(const HsvRangeKernel::Bounds& a, const HsvRangeKernel::Bounds& b) {
+            for (int c = 0; c < 3; ++c) {
+                if (a.lower[c] != b.lower[c] || a.upper[c] != b.upper[c]) return false;
+            }
+            return true;
+        }
+
+        // 阈值未变时沿用上一版本的查找表，否则在当前（加载）线程中重建
+        void prepare(Snapshot& s, const Snapshot* previous) {
+            s.hsv_bounds = HsvRangeKernel::make_bounds(s.lower_hsv, s.upper_hsv);
+            if (Config::HSV_THRESHOLD_MODE != Config::HsvThresholdMode::LookupTable) return;
+            if (previous && previous->hsv_lut && same_bounds(previous->hsv_bounds, s.hsv_bounds)) {
+                s.hsv_lut = previous->hsv_lut;
+            } else {
+                s.hsv_lut = std::make_shared<const HsvLookupTable>(HsvLookupTable::load_or_build(s.hsv_bounds, Config::HSV_LUT_CACHE_DIR));
+            }
+        }
+
+        SnapshotPtr& slot() {
+            static SnapshotPtr snapshot = [] {
+                auto s = std::make_shared<Snapshot>(defaults(Config::USE_LIVE_CAMERA));
+                prepare(*s, nullptr);
+                return SnapshotPtr(std::move(s));
+            }();
+            return snapshot;
+        }
+
+        std::mutex& reload_mutex() {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+        void publish(Snapshot&& next) {
+            std::atomic_store(&slot(), SnapshotPtr(std::make_shared<const Snapshot>(std::move(next))));
+        }
+    }
+
+    void load(const std::string& path) {
+        std::lock_guard<std::mutex> lock(reload_mutex());
+        Snapshot s;
+        if (!std::filesystem::exists(path)) {
+            s = defaults(Config::USE_LIVE_CAMERA);
+            std::cout << "[Info] Settings file " << path << " not found, using built-in defaults." << std::endl;
+        } else {
+            s = read_file(path);
+            std::cout << "[Info] Loaded settings from " << path << " (" << s.lanes.size() << " lanes)." << std::endl;
+        }
+        prepare(s, current().get());
+        s.version = 1;
+        publish(std::move(s));
+    }
+
+    SnapshotPtr current() {
+        return std::atomic_load(&slot());
+    }
+
+    bool reload(const std::string& path) {
+        std::lock_guard<std::mutex> lock(reload_mutex());
+        const SnapshotPtr previous = current();
+        Snapshot next;
+        try {
+            next = read_file(path, previous->use_live_camera);
+        } catch (const std::exception& e) {
+            std::cout << "[Warning] Settings reload rejected, keeping v" << previous->version << ": " << e.what() << std::endl;
+            return false;
+        }
+
+        // 车道对应轨迹表分区，增删或重排车道会丢失跟踪状态，需要重启
+        bool same_lanes = next.lanes.size() == previous->lanes.size();
+        for (size_t i = 0; same_lanes && i < next.lanes.size(); ++i) {
+            same_lanes = next.lanes[i].name == previous->lanes[i].name;
+        }
+        if (!same_lanes) {
+            std::cout << "[Warning] Settings reload rejected: lanes were added, removed or reordered (restart required)." << std::endl;
+            return false;
+        }
+        if (next.use_live_camera != previous->use_live_camera || next.datasets_path != previous->datasets_path
+            || next.dataset_indices != previous->dataset_indices || next.actuator_port != previous->actuator_port
+            || next.actuator_baud != previous->actuator_baud) {
+            std::cout << "[Warning] Changes to use_live_camera / datasets_path / dataset_indices / actuator_port / actuator_baud"
+                         " take effect after restart." << std::endl;
+            next.use_live_camera = previous->use_live_camera;
+            next.datasets_path = previous->datasets_path;
+            next.dataset_indices = previous->dataset_indices;
+            next.actuator_port = previous->actuator_port;
+            next.actuator_baud = previous->actuator_baud;
+        }
+
+        prepare(next, previous.get());
+        next.version = previous->version + 1;
+        const uint64_t version = next.version;
+        publish(std::move(next));
+        std::cout << "[Info] Settings v" << version << " applied from " << path << std::endl;
+        return true;
+    }
+
+    Watcher::Watcher(std::string path, std::chrono::milliseconds interval)
+        : m_path(std::move(path)), m_interval(interval) {
+        file_changed(); // 记录启动时的修改时间，避免立即重复加载
+        m_thread = std::thread([this] { run(); });
+    }
+
+    Watcher::~Watcher() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+    bool Watcher::file_changed() {
+        std::error_code ec;
+        const auto write_time = std::filesystem::last_write_time(m_path, ec);
+        if (ec || write_time == m_last_write) return false;
+        m_last_write = write_time;
+        return true;
+    }
+
+    void Watcher::run() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_cv.wait_for(lock, m_interval, [this] { return m_stop; })) {
+            if (file_changed()) reload(m_path);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef RUNTIMECONFIG_H
+#define RUNTIMECONFIG_H
+
+#include "Configuration.h"
+#include "HsvRangeKernel.h"
+#include "HsvLookupTable.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 运行期配置：启动时从 Config::SETTINGS_FILE 读入，文件缺失的键使用 Configuration.h 的默认值。
+// 配置以不可变快照发布（RCU 式）：采集线程每帧取一次当前快照并随帧传到下游各阶段，
+// 同一帧从分割到显示看到的是同一版本；热加载只是原子替换指针，旧快照在最后一帧释放引用后析构。
+namespace RuntimeConfig {
+    struct Snapshot {
+        uint64_t version = 0;
+
+        // --- 启动参数：只在启动时生效，热加载时的修改会被忽略 ---
+        bool use_live_camera = Config::USE_LIVE_CAMERA;
+        std::vector<std::string> datasets_path;
+        std::vector<int> dataset_indices;
+        std::string actuator_port = Config::ACTUATOR_PORT;
+        int actuator_baud = Config::ACTUATOR_BAUD;
+
+        // --- 可热切换：在帧间整体替换 ---
+        cv::Scalar lower_hsv, upper_hsv;
+        int min_area = Config::MIN_AREA_THRESHOLD;
+        float max_distance = Config::MAX_DISTANCE_FOR_TRACKING;
+        int max_missed_frames = Config::MAX_MISSED_FRAMES;
+        int action_delay_ms = Config::ACTION_DELAY_MS;
+        cv::Point2f initial_movement;
+        // 车道数量与名称在启动后固定（对应轨迹表分区），ROI、编号区间、分拣序列可以修改
+        std::vector<Config::Lane> lanes;
+
+        // --- 派生资源：发布前在加载线程中准备好，热路径不做任何构建 ---
+        HsvRangeKernel::Bounds hsv_bounds{};
+        std::shared_ptr<const HsvLookupTable> hsv_lut; // 仅 HsvThresholdMode::LookupTable 时非空
+    };
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
+    // 启动时调用一次：文件不存在则使用默认值；文件格式或取值错误时抛出 std::runtime_error
+    void load(const std::string& path = Config::SETTINGS_FILE);
+
+    // 当前快照（未调用 load 时为默认配置）
+    SnapshotPtr current();
+
+    // 帧上携带的快照为空时（如基准程序直接构造的帧）退回当前快照
+    inline SnapshotPtr resolve(const SnapshotPtr& snapshot) { return snapshot ? snapshot : current(); }
+
+    // 重新读取配置文件：解析、校验并准备好派生资源后原子替换当前快照。
+    // 任何错误都只打印警告并保留旧快照；返回是否发布了新版本
+    bool reload(const std::string& path = Config::SETTINGS_FILE);
+
+    // 后台轮询配置文件的修改时间，变化时调用 reload；析构时停止
+    class Watcher {
+    public:
+        explicit Watcher(std::string path = Config::SETTINGS_FILE,
+                         std::chrono::milliseconds interval = std::chrono::milliseconds(Config::SETTINGS_POLL_MS));
+        ~Watcher();
+        Watcher(const Watcher&) = delete;
+        Watcher& operator=(const Watcher&) = delete;
+
+    private:
+        void run();
+        bool file_changed();
+
+        std::string m_path;
+        std::chrono::milliseconds m_interval;
+        std::filesystem::file_time_type m_last_write{};
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        bool m_stop = false;
+        std::thread m_thread;
+    };
+}
+
+#endif //RUNTIMECONFIG_H
@@ -1,6 +1,13 @@
 #include "ImageTracker.h"
 #include "config/Configuration.h"
-#include "SimpleSerial.h"
+#include "config/RuntimeConfig.h"
+#include "ActuatorLink.h"
+#include "BatchRunner.h"
+#include "FrameRecording.h"
+#include "HsvRangeKernel.h"
+#include "utils/ShutdownSignal.h"
+#include "utils/Trace.h"
+#include <fstream>
 #include <iostream>
 #include <vector>
 #include <string>
@@ -17,48 +24,153 @@ void enable_virtual_terminal_processing() {
 }
 #endif
 
+// --batch [目录或录制文件 ...]：无界面批处理。未给目录时使用配置中的 dataset_indices；@文件 表示每行一个目录
+bool parse_batch_args(int argc, char* argv[], std::vector<std::string>& folders) {
+    bool batch = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--batch") {
+            batch = true;
+        } else if (batch && arg.size() > 1 && arg[0] == '@') {
+            std::ifstream list(arg.substr(1));
+            if (!list.is_open()) throw std::runtime_error("Could not open batch list " + arg.substr(1));
+            for (std::string line; std::getline(list, line);) {
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                if (!line.empty() && line[0] != '#') folders.push_back(line);
+            }
+        } else if (batch) {
+            folders.push_back(arg);
+        }
+    }
+    return batch;
+}
+
+// --convert <图片目录> <输出文件> [raw|roi|png]：把数据集目录转换为录制文件（默认 raw）
+int convert_recording(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " --convert <image dir> <output" << Config::RECORDING_EXTENSION << "> [raw|roi|png]" << std::endl;
+        return 1;
+    }
+    const std::string mode = argc > 4 ? argv[4] : "raw";
+    Config::RecordingPayload payload;
+    if (mode == "raw") payload = Config::RecordingPayload::Raw;
+    else if (mode == "roi") payload = Config::RecordingPayload::RoiCrop;
+    else if (mode == "png") payload = Config::RecordingPayload::Png;
+    else {
+        std::cerr << "[FATAL ERROR] Unknown payload '" << mode << "' (expected raw, roi or png)" << std::endl;
+        return 1;
+    }
+    try {
+        convert_image_directory(argv[2], argv[3], payload, Config::VIDEO_FPS);
+    } catch (const std::exception& e) {
+        std::cerr << "[FATAL ERROR] converting " << argv[2] << ": " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     #ifdef _WIN32
         enable_virtual_terminal_processing();
     #endif
+    // Ctrl+C / SIGTERM 让正在运行的会话正常收尾；须在任何线程启动前安装
+    ShutdownSignal::install();
 
-    SimpleSerial serial("COM3", 9600);
-    if (!serial.isConnected()) {
-        std::cerr << "Serial connection failed. Continuing without hardware control." << std::endl;
+    // 配置在任何流水线线程启动前读入
+    try {
+        RuntimeConfig::load();
+    } catch (const std::exception& e) {
+        std::cerr << "[FATAL ERROR] loading settings: " << e.what() << std::endl;
+        return 1;
     }
+    const RuntimeConfig::SnapshotPtr startup_config = RuntimeConfig::current();
+    // 转换只需要车道配置（roi 模式的裁剪区域）
+    if (argc > 1 && std::string(argv[1]) == "--convert") return convert_recording(argc, argv);
 
-    if constexpr (Config::USE_LIVE_CAMERA) {
+    std::vector<std::string> batch_folders;
+    bool batch_mode = false;
+    try {
+        batch_mode = parse_batch_args(argc, argv, batch_folders);
+    } catch (const std::exception& e) {
+        std::cerr << "[FATAL ERROR] " << e.what() << std::endl;
+        return 1;
+    }
+    if (batch_mode) {
+        // 批处理不显示、不录像、不连接执行器，结束后直接退出
+        std::cout << "--- Starting in BATCH mode ---" << std::endl;
+        if (batch_folders.empty()) {
+            for (int index : startup_config->dataset_indices) {
+                if (index < 0 || index >= (int)startup_config->datasets_path.size()) {
+                    std::cerr << "[Warning] Index " << index << " is out of bounds. Skipping." << std::endl;
+                    continue;
+                }
+                batch_folders.push_back(startup_config->datasets_path[index]);
+            }
+        }
+        BatchRunner runner;
+        runner.report(runner.run(batch_folders));
+        Trace::report(false);
+        if (!Config::TRACE_CHROME_PATH.empty()) Trace::write_chrome_trace(Config::TRACE_CHROME_PATH);
+        return 0;
+    }
+
+    // 只有数据集 / 实时跟踪会话热加载配置：后台线程监视文件，修改后在帧间切换；转换与批处理固定使用启动时的配置
+    RuntimeConfig::Watcher settings_watcher;
+
+    // 执行器链路在后台连接和断线重连；端口暂时不可用时照常处理，命令按过期规则丢弃
+    ActuatorLink actuator(make_actuator_transport(startup_config->actuator_port, startup_config->actuator_baud,
+                                                  Config::ACTUATOR_WRITE_TIMEOUT_MS));
+    Trace::Reporter latency_reporter(std::chrono::milliseconds(Config::TRACE_REPORT_INTERVAL_MS));
+
+    if (!Config::DISPLAY_ENABLED) {
+        std::cout << "[INFO] Headless build: no display window, no video recording" << std::endl;
+    }
+    if (Config::HSV_THRESHOLD_MODE == Config::HsvThresholdMode::Fused) {
+        std::cout << "[INFO] Fused HSV threshold kernel: " << HsvRangeKernel::active_isa() << std::endl;
+    }
+
+    if (startup_config->use_live_camera) {
         std::cout << "--- Starting in LIVE CAMERA mode ---" << std::endl;
         try {
             ImageTracker::Settings settings;
+            settings.encoder_overflow = OverflowPolicy::DropNewest;
             ImageTracker tracker(settings);
-            tracker.runFromCamera(&serial);
+            // 无界面构建没有 ESC，停止实时会话只能靠信号
+            ShutdownSignal::Scope stop_on_signal([&tracker] { tracker.request_stop(); });
+            tracker.runFromCamera(&actuator);
         } catch (const std::exception& e) {
             std::cerr << "[FATAL ERROR] in live camera mode: " << e.what() << std::endl;
         }
     } else {
         std::cout << "--- Starting in LOCAL DATASET mode ---" << std::endl;
-        for (int index : Config::DATASET_INDICES_TO_RUN) {
-            if (index >= Config::DATASETS_PATH.size()) {
+        for (int index : startup_config->dataset_indices) {
+            if (ShutdownSignal::requested()) break;
+            if (index < 0 || index >= (int)startup_config->datasets_path.size()) {
                 std::cerr << "[Warning] Index " << index << " is out of bounds. Skipping." << std::endl;
                 continue;
             }
-            std::string current_folder = Config::DATASETS_PATH[index];
+            std::string current_folder = startup_config->datasets_path[index];
             std::cout << "\n\n--- Processing Folder: " << current_folder << " ---" << std::endl;
             try {
                 ImageTracker::Settings settings;
                 settings.input_path = current_folder;
                 ImageTracker tracker(settings);
-                tracker.runFromDataset(&serial);
+                ShutdownSignal::Scope stop_on_signal([&tracker] { tracker.request_stop(); });
+                tracker.runFromDataset(&actuator);
             } catch (const std::exception& e) {
                 std::cerr << "[FATAL ERROR] in folder " << current_folder << ": " << e.what() << std::endl;
             }
         }
     }
 
+    actuator.report();
+    Trace::report(false);
+    if (!Config::TRACE_CHROME_PATH.empty()) Trace::write_chrome_trace(Config::TRACE_CHROME_PATH);
     std::cout << "\n\n--- All processing finished. ---" << std::endl;
-    if (!Config::USE_LIVE_CAMERA) {
+#ifndef APPLE_TRACKER_HEADLESS
+    if (!startup_config->use_live_camera && !ShutdownSignal::requested()) {
         cv::waitKey(0);
     }
+#endif
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "BufferPool.h"
+#include <new>
+
+BufferPool& BufferPool::instance() {
+    static BufferPool pool;
+    return pool;
+}
+
+BufferPool::~BufferPool() {
+    trim();
+    for (void* header : m_free_headers) ::operator delete(header);
+}
+
+cv::Mat BufferPool::make() const {
+    cv::Mat mat;
+    mat.allocator = const_cast<BufferPool*>(this);
+    return mat;
+}
+
+cv::Mat BufferPool::acquire(cv::Size size, int type) const {
+    cv::Mat mat = make();
+    mat.create(size, type);
+    return mat;
+}
+
+BufferPool::Counters BufferPool::counters() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_counters;
+}
+
+void BufferPool::trim() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& bucket : m_free_slabs) {
+        for (uchar* slab : bucket.second) {
+            cv::fastFree(slab);
+            m_counters.bytes_reserved -= bucket.first;
+        }
+        bucket.second.clear();
+    }
+    m_counters.slabs_idle = 0;
+}
+
+void* BufferPool::take_header() const {
+    if (!m_free_headers.empty()) {
+        void* header = m_free_headers.back();
+        m_free_headers.pop_back();
+        return header;
+    }
+    m_counters.header_allocations++;
+    return ::operator new(sizeof(cv::UMatData));
+}
+
+// 与 cv::StdMatAllocator 的步长计算一致，只是内存来自池
+cv::UMatData* BufferPool::allocate(int dims, const int* sizes, int type, void* data0, size_t* step,
+                                   cv::AccessFlag, cv::UMatUsageFlags) const {
+    size_t total = CV_ELEM_SIZE(type);
+    for (int i = dims - 1; i >= 0; i--) {
+        if (step) {
+            if (data0 && step[i] != CV_AUTOSTEP) {
+                CV_Assert(total <= step[i]);
+                total = step[i];
+            } else {
+                step[i] = total;
+            }
+        }
+        total *= sizes[i];
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uchar* data = (uchar*)data0;
+    if (!data) {
+        auto& bucket = m_free_slabs[total];
+        if (!bucket.empty()) {
+            data = bucket.back();
+            bucket.pop_back();
+            m_counters.reuses++;
+            m_counters.slabs_idle--;
+        } else {
+            data = (uchar*)cv::fastMalloc(total);
+            m_counters.slab_allocations++;
+            m_counters.bytes_reserved += total;
+        }
+        m_counters.slabs_in_use++;
+    }
+
+    cv::UMatData* u = new (take_header()) cv::UMatData(this);
+    u->data = u->origdata = data;
+    u->size = total;
+    if (data0) u->flags |= cv::UMatData::USER_ALLOCATED;
+    return u;
+}
+
+bool BufferPool::allocate(cv::UMatData* u, cv::AccessFlag, cv::UMatUsageFlags) const {
+    return u != nullptr;
+}
+
+void BufferPool::deallocate(cv::UMatData* u) const {
+    if (!u) return;
+    CV_Assert(u->urefcount == 0);
+    CV_Assert(u->refcount == 0);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!(u->flags & cv::UMatData::USER_ALLOCATED)) {
+        m_free_slabs[u->size].push_back(u->origdata);
+        u->origdata = 0;
+        m_counters.returns++;
+        m_counters.slabs_in_use--;
+        m_counters.slabs_idle++;
+    }
+    u->~UMatData();
+    m_free_headers.push_back(u);
+}
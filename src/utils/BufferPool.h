@@ -0,0 +1,57 @@
+#ifndef BUFFERPOOL_H
+#define BUFFERPOOL_H
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <vector>
+
+// 帧缓冲池：实现 cv::MatAllocator，把采集、解码、分割中间结果和显示帧的像素内存循环复用。
+// - slab 按字节数分桶（即分辨率 × 类型），最后一个引用释放时 Mat 的内存回到对应桶的空闲链表
+// - UMatData 头也从空闲链表中原地构造，稳态下每帧不再有任何像素缓冲区的堆分配
+// - 计数器中 slab_allocations 在预热后应保持不变，用来证明这一点
+// 用法：cv::Mat m = BufferPool::instance().make(); 之后把 m 作为 OpenCV 函数的输出参数即可。
+class BufferPool : public cv::MatAllocator {
+public:
+    struct Counters {
+        uint64_t slab_allocations = 0;   // 真正向系统申请的 slab 数
+        uint64_t header_allocations = 0; // 真正向系统申请的 UMatData 头数
+        uint64_t reuses = 0;             // 从空闲链表复用的次数
+        uint64_t returns = 0;            // 归还到空闲链表的次数
+        size_t slabs_in_use = 0;
+        size_t slabs_idle = 0;
+        size_t bytes_reserved = 0;       // 池持有的全部 slab 字节数（在用 + 空闲）
+    };
+
+    static BufferPool& instance();
+
+    ~BufferPool() override;
+
+    // 空 Mat，首次 create 时从池中取 slab
+    cv::Mat make() const;
+    // 指定尺寸与类型的池化 Mat（内容未初始化）
+    cv::Mat acquire(cv::Size size, int type) const;
+
+    Counters counters() const;
+    // 释放所有空闲 slab（例如一轮数据集处理结束后）
+    void trim();
+
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                           cv::AccessFlag flags, cv::UMatUsageFlags usage_flags) const override;
+    bool allocate(cv::UMatData* data, cv::AccessFlag access_flags, cv::UMatUsageFlags usage_flags) const override;
+    void deallocate(cv::UMatData* data) const override;
+
+private:
+    BufferPool() = default;
+
+    void* take_header() const;
+
+    mutable std::mutex m_mutex;
+    mutable std::map<size_t, std::vector<uchar*>> m_free_slabs;
+    mutable std::vector<void*> m_free_headers;
+    mutable Counters m_counters;
+};
+
+#endif //BUFFERPOOL_H
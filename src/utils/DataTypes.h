@@ -2,13 +2,43 @@
 #define DATATYPES_H
 
 #include <opencv2/opencv.hpp>
+#include <array>
+#include <chrono>
+#include <memory>
 #include <string>
 #include <vector>
 
-struct ProducerTask { int frame_idx; cv::Mat image; };
-struct ConsumerResult { int frame_idx; cv::Mat original_image; cv::Mat labels; cv::Mat stats; cv::Mat centroids; };
-struct Detection { int label_id; cv::Point2f centroid; cv::Rect bbox; };
-struct TrackedObject { int unique_id; int assigned_number; int missed_frames = 0; cv::Point2f centroid; cv::Point2f velocity; cv::Scalar color; int current_label_id = -1; cv::Rect current_bbox; };
-struct TrackingStats { int frame; int assigned_number; int unique_id; float centroid_x; float centroid_y; };
+namespace RuntimeConfig { struct Snapshot; }
+// 采集时取得的配置快照，随帧传到各阶段，保证同一帧只看到一个配置版本
+using ConfigSnapshot = std::shared_ptr<const RuntimeConfig::Snapshot>;
+
+using CaptureTime = std::chrono::steady_clock::time_point;
+
+// 帧经过各阶段边界的单调时间戳，随帧传递，用于逐段延迟统计（见 utils/Trace.h）。
+// 采集时刻同时是速度换算与执行器到达时间预测的基准，与处理延迟无关
+struct FrameTimeline {
+    enum Mark { Captured, SegmentBegin, SegmentEnd, LabelBegin, LabelEnd, TrackBegin, TrackEnd, VisualizeBegin, VisualizeEnd, MarkCount };
+    std::array<CaptureTime, MarkCount> at{};
 
+    void stamp(Mark mark) { at[mark] = std::chrono::steady_clock::now(); }
+    CaptureTime captured() const { return at[Captured]; }
+};
+
+struct ProducerTask { int frame_idx; cv::Mat image; ConfigSnapshot config; FrameTimeline timeline; };
+struct SegmentedFrame { int frame_idx; cv::Mat original_image; std::vector<cv::Mat> roi_masks; ConfigSnapshot config; FrameTimeline timeline; };
+// 分割阶段直接输出的紧凑检测记录（已按 min_area 过滤），label_id 与整帧标签图中的标号一致
+struct Detection { int label_id; int roi_id; int area; cv::Point2f centroid; cv::Rect bbox; };
+// original_image / labels 为可选负载：cv::Mat 自带引用计数，为空表示未携带
+struct ConsumerResult { int frame_idx; cv::Mat original_image; std::vector<Detection> detections; cv::Mat labels; ConfigSnapshot config; FrameTimeline timeline; };
+struct TrackedObject { int unique_id; int assigned_number; int missed_frames = 0; cv::Point2f centroid; cv::Point2f velocity; cv::Scalar color; int current_label_id = -1; cv::Rect current_bbox; };
+// 实时录制队列中的一帧：采集原图（引用计数共享，不拷贝）与采集时刻
+struct RecordedFrame { int frame_idx; cv::Mat image; CaptureTime captured; };
+struct VisualFrame { int frame_idx; cv::Mat original_image; std::vector<TrackedObject> objects; ConfigSnapshot config; FrameTimeline timeline; };
+// 排定的执行器动作：到 trigger_time 时把 action_type 写给执行器
+struct PendingAction {
+    char action_type; // 车道的执行器代码（Config::Lane::action_code）
+    std::chrono::steady_clock::time_point trigger_time;
+    int frame_idx = -1;    // 排定该动作的帧，及其采集时刻（采集到执行的端到端延迟）
+    CaptureTime captured{};
+};
 #endif //DATATYPES_H
\ No newline at end of file
@@ -0,0 +1,98 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+// 对数-线性直方图（与 HdrHistogram 同思路）：[0, 8) 逐值计数，之后每个 2 的幂区间再细分 8 格，
+// 相对误差 < 12.5%，覆盖整个 int64 范围只需 496 个计数器，记录为 O(1) 且无分配。
+// 非线程安全：每个记录线程持有自己的实例，汇总时 merge。
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    // 负值（例如提前触发）按 0 计入，另外单独计数
+    void record(int64_t value) {
+        if (value < 0) {
+            m_negative++;
+            value = 0;
+        }
+        m_counts[bucket_of((uint64_t)value)]++;
+        m_count++;
+        m_sum += value;
+        m_min = (std::min)(m_min, value);
+        m_max = (std::max)(m_max, value);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (int i = 0; i < BUCKETS; ++i) m_counts[i] += other.m_counts[i];
+        m_count += other.m_count;
+        m_negative += other.m_negative;
+        m_sum += other.m_sum;
+        m_min = (std::min)(m_min, other.m_min);
+        m_max = (std::max)(m_max, other.m_max);
+    }
+
+    void reset() { *this = LatencyHistogram(); }
+
+    uint64_t count() const { return m_count; }
+    uint64_t negative_count() const { return m_negative; }
+    int64_t min() const { return m_count ? m_min : 0; }
+    int64_t max() const { return m_count ? m_max : 0; }
+    double mean() const { return m_count ? (double)m_sum / (double)m_count : 0.0; }
+
+    // 第 p 百分位（0~100）所在桶的上界，不超过实际最大值
+    int64_t percentile(double p) const {
+        if (m_count == 0) return 0;
+        const uint64_t rank = (uint64_t)(std::max)(1.0, p / 100.0 * (double)m_count + 0.5);
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKETS; ++i) {
+            seen += m_counts[i];
+            if (seen >= rank) return (std::min)((int64_t)bucket_upper(i), m_max);
+        }
+        return m_max;
+    }
+
+    // 遍历非空桶：f(lower, upper, count)，用于导出完整分布
+    template<typename F>
+    void for_each_bucket(F&& f) const {
+        for (int i = 0; i < BUCKETS; ++i) {
+            if (m_counts[i]) f(bucket_lower(i), bucket_upper(i), m_counts[i]);
+        }
+    }
+
+private:
+    static int bucket_of(uint64_t v) {
+        if (v < (uint64_t)SUB_BUCKETS) return (int)v;
+        int e = 63;
+        while (!((v >> e) & 1)) --e; // 最高位
+        const int sub = (int)((v >> (e - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+        return (e - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+    }
+
+    static uint64_t bucket_lower(int i) {
+        if (i < SUB_BUCKETS) return (uint64_t)i;
+        const int e = i / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+        const uint64_t sub = (uint64_t)(i % SUB_BUCKETS);
+        return ((uint64_t)SUB_BUCKETS + sub) << (e - SUB_BUCKET_BITS);
+    }
+
+    static uint64_t bucket_upper(int i) {
+        if (i < SUB_BUCKETS) return (uint64_t)i;
+        const int e = i / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+        return bucket_lower(i) + (((uint64_t)1 << (e - SUB_BUCKET_BITS)) - 1);
+    }
+
+    std::array<uint64_t, BUCKETS> m_counts{};
+    uint64_t m_count = 0;
+    uint64_t m_negative = 0;
+    int64_t m_sum = 0;
+    int64_t m_min = std::numeric_limits<int64_t>::max();
+    int64_t m_max = std::numeric_limits<int64_t>::min();
+};
+
+#endif //LATENCYHISTOGRAM_H
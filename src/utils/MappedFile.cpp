@@ -0,0 +1,83 @@
+#include "MappedFile.h"
+#include <algorithm>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path) {
+    m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Could not open " + path + " (error " + std::to_string(GetLastError()) + ")");
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size)) {
+        CloseHandle(m_file);
+        throw std::runtime_error("Could not get size of " + path);
+    }
+    m_size = (size_t)size.QuadPart;
+    if (m_size == 0) return;
+    m_mapping = CreateFileMappingA(m_file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (m_mapping) m_data = (uint8_t*)MapViewOfFile(m_mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (!m_data) {
+        const DWORD error = GetLastError();
+        if (m_mapping) CloseHandle(m_mapping);
+        CloseHandle(m_file);
+        throw std::runtime_error("Could not map " + path + " (error " + std::to_string(error) + ")");
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(m_mapping);
+    if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+}
+
+void MappedFile::prefetch(size_t, size_t) const {}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Could not open " + path + ": " + std::strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        const int error = errno;
+        ::close(fd);
+        throw std::runtime_error("Could not stat " + path + ": " + std::strerror(error));
+    }
+    m_size = (size_t)st.st_size;
+    if (m_size > 0) {
+        void* p = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            const int error = errno;
+            ::close(fd);
+            throw std::runtime_error("Could not map " + path + ": " + std::strerror(error));
+        }
+        m_data = (uint8_t*)p;
+    }
+    // 映射建立后即可关闭描述符
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (m_data) munmap(m_data, m_size);
+}
+
+void MappedFile::prefetch(size_t offset, size_t length) const {
+    if (!m_data || offset >= m_size) return;
+    static const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t begin = offset / page * page;
+    const size_t end = (std::min)(offset + length, m_size);
+    madvise(m_data + begin, end - begin, MADV_WILLNEED);
+}
+
+#endif
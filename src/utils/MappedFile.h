@@ -0,0 +1,37 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// 只读打开、写时复制映射的整个文件：读取方直接在映射内存上构造 cv::Mat 视图，不经过 read() 拷贝；
+// 下游即便误写这些像素也只改动进程私有页，不会写回文件。打开失败时抛出 std::runtime_error。
+// 映射在对象析构时解除，指向其中的视图必须先于本对象释放。
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+    // 提示内核预读 [offset, offset + length)（POSIX madvise；Windows 上为空操作）
+    void prefetch(size_t offset, size_t length) const;
+
+private:
+    uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = NULL;
+#endif
+};
+
+#endif //MAPPED_FILE_H
@@ -0,0 +1,84 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "Trace.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 极简流水线调度器：每个阶段拥有独立线程（或线程池），阻塞在输入队列上，不做任何轮询。
+// 输入队列只需提供 value_type 和 bool wait_and_pop(value_type&)，关闭且取空后返回 false（RingQueue / ReorderBuffer 均满足）。
+// 阶段的最后一个工作线程退出时调用 on_finish，通常用来关闭下游队列，使结束信号沿流水线逐级传递。
+class Pipeline {
+public:
+    Pipeline() = default;
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+    ~Pipeline() { join(); }
+
+    // 源阶段：body 自行产生数据，返回即表示结束
+    void add_source(const std::string& name, std::function<void()> body, std::function<void()> on_finish = {}) {
+        Stage& stage = new_stage(name, 1, std::move(on_finish));
+        m_threads.emplace_back([&stage, body = std::move(body)] {
+            Trace::name_thread(stage.name);
+            body();
+            finish(stage);
+        });
+    }
+
+    // 处理阶段：workers 个线程阻塞地从 input 取数据并调用 body(item)
+    template <typename Queue, typename Fn>
+    void add_stage(const std::string& name, Queue& input, unsigned int workers, Fn body, std::function<void()> on_finish = {}) {
+        if (workers == 0) workers = 1;
+        Stage& stage = new_stage(name, workers, std::move(on_finish));
+        for (unsigned int i = 0; i < workers; ++i) {
+            m_threads.emplace_back([&stage, &input, body, i] {
+                Trace::name_thread(stage.name + "#" + std::to_string(i));
+                typename Queue::value_type item;
+                while (input.wait_and_pop(item)) body(item);
+                finish(stage);
+            });
+        }
+    }
+
+    void join() {
+        for (auto& t : m_threads) {
+            if (t.joinable()) t.join();
+        }
+        m_threads.clear();
+    }
+
+    std::vector<std::string> stage_names() const {
+        std::vector<std::string> names;
+        for (const auto& s : m_stages) names.push_back(s->name);
+        return names;
+    }
+
+private:
+    struct Stage {
+        std::string name;
+        std::atomic<unsigned int> active;
+        std::function<void()> on_finish;
+    };
+
+    Stage& new_stage(const std::string& name, unsigned int workers, std::function<void()> on_finish) {
+        auto stage = std::make_unique<Stage>();
+        stage->name = name;
+        stage->active = workers;
+        stage->on_finish = std::move(on_finish);
+        m_stages.push_back(std::move(stage));
+        return *m_stages.back();
+    }
+
+    static void finish(Stage& stage) {
+        if (--stage.active == 0 && stage.on_finish) stage.on_finish();
+    }
+
+    std::vector<std::unique_ptr<Stage>> m_stages;
+    std::vector<std::thread> m_threads;
+};
+
+#endif //PIPELINE_H
@@ -0,0 +1,139 @@
+#ifndef REORDERBUFFER_H
+#define REORDERBUFFER_H
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+
+// 按序号重排缓冲区：多个消费者线程乱序 push，单个下游按序号严格递增地取出。
+// - window: 最大前瞻距离。若已收到 >= next + window 的序号而 next 仍未到达，
+//           则放弃等待 next（计入 skipped），防止丢帧导致整条流水线卡死。
+// - 序号小于当前 next 的迟到数据直接丢弃（计入 late）。
+template <typename T>
+class ReorderBuffer {
+public:
+    using value_type = T;
+
+    struct Counters {
+        uint64_t released = 0;    // 按序放出的条目数
+        uint64_t stalls = 0;      // 下游等待队首时已有乱序条目积压的次数
+        uint64_t skipped = 0;     // 因超出前瞻窗口或显式 skip 而跳过的序号数
+        uint64_t late = 0;        // 迟到（序号已被跳过）而被丢弃的条目数
+        size_t max_pending = 0;   // 积压条目数峰值
+    };
+
+    explicit ReorderBuffer(int window = 64, int first_sequence = 0)
+        : m_window(window > 0 ? window : 1), m_next(first_sequence) {}
+
+    void push(int sequence, T value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        insert_locked(sequence, std::optional<T>(std::move(value)));
+    }
+
+    // 标记某个序号不会产生结果（如读图失败），下游不必等待它
+    void skip(int sequence) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        insert_locked(sequence, std::nullopt);
+    }
+
+    // 阻塞直到下一个序号就绪；缓冲区已关闭且无可放出的条目时返回 false
+    bool wait_and_pop(T& value) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        bool stalled = false;
+        while (true) {
+            if (pop_locked(value)) return true;
+            if (m_closed) {
+                // 关闭后不再有新数据，剩余空洞全部跳过
+                if (m_pending.empty()) return false;
+                m_counters.skipped += m_pending.begin()->first - m_next;
+                m_next = m_pending.begin()->first;
+                continue;
+            }
+            if (!stalled && !m_pending.empty()) {
+                stalled = true;
+                m_counters.stalls++;
+            }
+            m_cond.wait(lock);
+        }
+    }
+
+    bool try_pop(T& value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return pop_locked(value);
+    }
+
+    // 背压：阻塞直到 sequence 落入前瞻窗口 [next, next + window)，保证在途帧数有界。
+    // 缓冲区关闭时返回 false。
+    bool wait_for_slot(int sequence) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_slot_cond.wait(lock, [&] { return sequence < m_next + m_window || m_closed; });
+        return !m_closed;
+    }
+
+    // 所有生产者结束后调用，唤醒等待中的下游
+    void close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_cond.notify_all();
+        m_slot_cond.notify_all();
+    }
+
+    int next_sequence() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_next;
+    }
+
+    Counters counters() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_counters;
+    }
+
+private:
+    void insert_locked(int sequence, std::optional<T>&& value) {
+        if (sequence < m_next) {
+            if (value) m_counters.late++;
+            return;
+        }
+        m_pending[sequence] = std::move(value);
+        if (m_pending.size() > m_counters.max_pending) m_counters.max_pending = m_pending.size();
+        m_cond.notify_one();
+    }
+
+    bool pop_locked(T& value) {
+        while (!m_pending.empty()) {
+            auto head = m_pending.begin();
+            if (head->first != m_next) {
+                // 队首缺失：仅当前瞻超出窗口时才放弃等待
+                if (m_pending.rbegin()->first < m_next + m_window) return false;
+                m_counters.skipped += head->first - m_next;
+                m_next = head->first;
+            }
+            std::optional<T> item = std::move(head->second);
+            m_pending.erase(head);
+            m_next++;
+            m_slot_cond.notify_all();
+            if (!item) {
+                m_counters.skipped++;
+                continue;
+            }
+            value = std::move(*item);
+            m_counters.released++;
+            return true;
+        }
+        return false;
+    }
+
+    const int m_window;
+    int m_next;
+    bool m_closed = false;
+    std::map<int, std::optional<T>> m_pending;
+    Counters m_counters;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::condition_variable m_slot_cond;
+};
+
+#endif //REORDERBUFFER_H
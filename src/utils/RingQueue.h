@@ -0,0 +1,316 @@
+#ifndef RINGQUEUE_H
+#define RINGQUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+// 有界环形队列族。
+// - SpscRing: 单生产者/单消费者，Lamport 环，无 CAS
+// - MpmcRing: 多生产者/多消费者，Vyukov 有界队列，每个槽位带序号
+// 入队/出队的快路径无锁；阻塞操作只在队列满/空时才进入 mutex + condition_variable 休眠，
+// 对端只有在确实有人等待时才加锁唤醒。
+
+namespace detail {
+
+    constexpr size_t CACHE_LINE = 64;
+
+    inline size_t round_up_pow2(size_t n) {
+        size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    template <typename T>
+    class SpscRing {
+    public:
+        static constexpr bool MULTI_CONSUMER = false;
+
+        explicit SpscRing(size_t capacity)
+            : m_mask(round_up_pow2(capacity) - 1), m_buffer(new T[m_mask + 1]) {}
+
+        size_t capacity() const { return m_mask + 1; }
+
+        bool try_push(T& value) {
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) > m_mask) return false;
+            m_buffer[tail & m_mask] = std::move(value);
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_pop(T& value) {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire)) return false;
+            value = std::move(m_buffer[head & m_mask]);
+            m_buffer[head & m_mask] = T();
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_t size() const {
+            const size_t tail = m_tail.load(std::memory_order_acquire);
+            const size_t head = m_head.load(std::memory_order_acquire);
+            return tail - head;
+        }
+
+    private:
+        const size_t m_mask;
+        std::unique_ptr<T[]> m_buffer;
+        alignas(CACHE_LINE) std::atomic<size_t> m_head = {0};
+        alignas(CACHE_LINE) std::atomic<size_t> m_tail = {0};
+    };
+
+    template <typename T>
+    class MpmcRing {
+    public:
+        static constexpr bool MULTI_CONSUMER = true;
+
+        explicit MpmcRing(size_t capacity)
+            : m_mask(round_up_pow2(capacity) - 1), m_cells(new Cell[m_mask + 1]) {
+            for (size_t i = 0; i <= m_mask; ++i) m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        size_t capacity() const { return m_mask + 1; }
+
+        bool try_push(T& value) {
+            Cell* cell;
+            size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            while (true) {
+                cell = &m_cells[pos & m_mask];
+                const size_t seq = cell->sequence.load(std::memory_order_acquire);
+                const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+                if (diff == 0) {
+                    if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = m_enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            cell->data = std::move(value);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_pop(T& value) {
+            Cell* cell;
+            size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            while (true) {
+                cell = &m_cells[pos & m_mask];
+                const size_t seq = cell->sequence.load(std::memory_order_acquire);
+                const intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+                if (diff == 0) {
+                    if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = m_dequeue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            value = std::move(cell->data);
+            cell->data = T();
+            cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_t size() const {
+            const size_t enq = m_enqueue_pos.load(std::memory_order_acquire);
+            const size_t deq = m_dequeue_pos.load(std::memory_order_acquire);
+            return enq > deq ? enq - deq : 0;
+        }
+
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            T data;
+        };
+        const size_t m_mask;
+        std::unique_ptr<Cell[]> m_cells;
+        alignas(CACHE_LINE) std::atomic<size_t> m_enqueue_pos = {0};
+        alignas(CACHE_LINE) std::atomic<size_t> m_dequeue_pos = {0};
+    };
+
+} // namespace detail
+
+// 队列满时 push 的行为
+enum class OverflowPolicy {
+    Block,       // 阻塞等待空位（背压），用于数据集回放
+    DropOldest,  // 丢弃最旧的一项再入队，用于实时采集（仅 MPMC）
+    DropNewest   // 直接拒绝新数据
+};
+
+template <typename T, typename Ring>
+class BoundedQueue {
+public:
+    using value_type = T;
+
+    struct Counters {
+        size_t capacity = 0;
+        size_t depth = 0;           // 当前深度
+        size_t high_watermark = 0;  // 深度峰值
+        uint64_t pushed = 0;
+        uint64_t popped = 0;
+        uint64_t dropped = 0;       // 因队列满被丢弃的项
+        uint64_t producer_waits = 0;
+        uint64_t consumer_waits = 0;
+        double occupancy() const { return capacity ? (double)depth / capacity : 0.0; }
+    };
+
+    explicit BoundedQueue(size_t capacity, OverflowPolicy policy = OverflowPolicy::Block)
+        : m_ring(capacity) {
+        set_overflow_policy(policy);
+    }
+
+    // 仅应在生产者启动前调用
+    void set_overflow_policy(OverflowPolicy policy) {
+        if (policy == OverflowPolicy::DropOldest && !Ring::MULTI_CONSUMER) {
+            // 生产者丢弃队首会与唯一的消费者竞争
+            throw std::invalid_argument("DropOldest requires a multi-consumer queue");
+        }
+        m_policy = policy;
+    }
+
+    // 按构造时的溢出策略入队。成功入队返回 true；被拒绝或队列已关闭返回 false。
+    bool push(T value) {
+        return push(std::move(value), [](T&&) {});
+    }
+
+    // 同上；DropOldest 策略下每个被挤出的旧项按出队顺序交给 on_evict(T&&)，调用方可据此登记跳帧。
+    // 其他生产者同时入队、抢先占用腾出的位置时，一次 push 可能挤出多项
+    template <typename OnEvict>
+    bool push(T value, OnEvict&& on_evict) {
+        if (m_closed.load(std::memory_order_acquire)) return false;
+        while (!m_ring.try_push(value)) {
+            if (m_policy == OverflowPolicy::DropNewest) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            if (m_policy == OverflowPolicy::DropOldest) {
+                T oldest;
+                if (m_ring.try_pop(oldest)) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    on_evict(std::move(oldest));
+                }
+                continue;
+            }
+            if (!wait_not_full()) return false;
+        }
+        after_push();
+        return true;
+    }
+
+    bool try_push(T value) {
+        if (m_closed.load(std::memory_order_acquire)) return false;
+        if (!m_ring.try_push(value)) return false;
+        after_push();
+        return true;
+    }
+
+    // 阻塞直到取到一项；队列关闭且已取空时返回 false
+    bool wait_and_pop(T& value) {
+        while (!m_ring.try_pop(value)) {
+            if (!wait_not_empty()) return false;
+        }
+        after_pop();
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        if (!m_ring.try_pop(value)) return false;
+        after_pop();
+        return true;
+    }
+
+    // 关闭后不再接受新数据；等待中的生产者/消费者全部被唤醒，消费者仍可取完剩余数据
+    void close() {
+        m_closed.store(true, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_not_empty.notify_all();
+        m_not_full.notify_all();
+    }
+
+    bool closed() const { return m_closed.load(std::memory_order_acquire); }
+    size_t size() const { return m_ring.size(); }
+    size_t capacity() const { return m_ring.capacity(); }
+
+    Counters counters() const {
+        Counters c;
+        c.capacity = m_ring.capacity();
+        c.depth = m_ring.size();
+        c.high_watermark = m_high_watermark.load(std::memory_order_relaxed);
+        c.pushed = m_pushed.load(std::memory_order_relaxed);
+        c.popped = m_popped.load(std::memory_order_relaxed);
+        c.dropped = m_dropped.load(std::memory_order_relaxed);
+        c.producer_waits = m_producer_waits.load(std::memory_order_relaxed);
+        c.consumer_waits = m_consumer_waits.load(std::memory_order_relaxed);
+        return c;
+    }
+
+private:
+    void after_push() {
+        m_pushed.fetch_add(1, std::memory_order_relaxed);
+        const size_t depth = m_ring.size();
+        size_t peak = m_high_watermark.load(std::memory_order_relaxed);
+        while (depth > peak && !m_high_watermark.compare_exchange_weak(peak, depth, std::memory_order_relaxed)) {}
+        // 与等待方的 fetch_add 构成 Dekker 式配对：要么对方看到新数据，要么我们看到对方在等
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiting_consumers.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_not_empty.notify_one();
+        }
+    }
+
+    void after_pop() {
+        m_popped.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiting_producers.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_not_full.notify_one();
+        }
+    }
+
+    bool wait_not_empty() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_waiting_consumers.fetch_add(1, std::memory_order_seq_cst);
+        m_consumer_waits.fetch_add(1, std::memory_order_relaxed);
+        m_not_empty.wait(lock, [this] { return m_ring.size() > 0 || closed(); });
+        m_waiting_consumers.fetch_sub(1, std::memory_order_relaxed);
+        return m_ring.size() > 0;
+    }
+
+    bool wait_not_full() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_waiting_producers.fetch_add(1, std::memory_order_seq_cst);
+        m_producer_waits.fetch_add(1, std::memory_order_relaxed);
+        m_not_full.wait(lock, [this] { return m_ring.size() < m_ring.capacity() || closed(); });
+        m_waiting_producers.fetch_sub(1, std::memory_order_relaxed);
+        return !closed();
+    }
+
+    Ring m_ring;
+    OverflowPolicy m_policy = OverflowPolicy::Block;
+    std::atomic<bool> m_closed = {false};
+
+    std::atomic<int> m_waiting_consumers = {0};
+    std::atomic<int> m_waiting_producers = {0};
+    std::mutex m_mutex;
+    std::condition_variable m_not_empty;
+    std::condition_variable m_not_full;
+
+    std::atomic<size_t> m_high_watermark = {0};
+    std::atomic<uint64_t> m_pushed = {0};
+    std::atomic<uint64_t> m_popped = {0};
+    std::atomic<uint64_t> m_dropped = {0};
+    std::atomic<uint64_t> m_producer_waits = {0};
+    std::atomic<uint64_t> m_consumer_waits = {0};
+};
+
+template <typename T> using SpscQueue = BoundedQueue<T, detail::SpscRing<T>>;
+template <typename T> using MpmcQueue = BoundedQueue<T, detail::MpmcRing<T>>;
+
+#endif //RINGQUEUE_H
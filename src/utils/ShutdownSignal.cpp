@@ -0,0 +1,88 @@
+#include "ShutdownSignal.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <csignal>
+#include <pthread.h>
+#endif
+
+namespace ShutdownSignal {
+    namespace {
+        std::atomic<bool> g_requested = {false};
+        std::mutex g_mutex; // 保护 g_on_stop：回调执行期间 Scope 不能析构
+        std::condition_variable g_cleared;
+        std::function<void()> g_on_stop;
+
+        // 已有回调且是第一次收到信号时调用回调并返回 true；否则返回 false，由调用方结束进程
+        bool dispatch(const char* name) {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            if (!g_on_stop || g_requested.exchange(true)) return false;
+            std::cout << "\n[Info] Received " << name << ", stopping after the frames in flight (repeat to exit immediately)." << std::endl;
+            g_on_stop();
+            return true;
+        }
+
+#ifdef _WIN32
+        BOOL WINAPI console_handler(DWORD event) {
+            switch (event) {
+                case CTRL_C_EVENT:
+                case CTRL_BREAK_EVENT:
+                    return dispatch(event == CTRL_C_EVENT ? "Ctrl+C" : "Ctrl+Break") ? TRUE : FALSE;
+                case CTRL_CLOSE_EVENT: {
+                    if (!dispatch("console close")) return FALSE;
+                    // 处理函数返回后系统立即结束进程（最多等约 5 秒）：等会话收尾、Scope 注销后再返回
+                    std::unique_lock<std::mutex> lock(g_mutex);
+                    g_cleared.wait_for(lock, std::chrono::milliseconds(4500), [] { return !g_on_stop; });
+                    return TRUE;
+                }
+                default:
+                    return FALSE;
+            }
+        }
+#endif
+    }
+
+    void install() {
+#ifdef _WIN32
+        SetConsoleCtrlHandler(console_handler, TRUE);
+#else
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+        std::thread([signals] {
+            while (true) {
+                int signal = 0;
+                if (sigwait(&signals, &signal) != 0) continue;
+                if (!dispatch(signal == SIGINT ? "SIGINT" : "SIGTERM")) std::_Exit(128 + signal);
+            }
+        }).detach();
+#endif
+    }
+
+    bool requested() {
+        return g_requested.load();
+    }
+
+    Scope::Scope(std::function<void()> on_stop) {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_on_stop = std::move(on_stop);
+    }
+
+    Scope::~Scope() {
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            g_on_stop = nullptr;
+        }
+        g_cleared.notify_all();
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef SHUTDOWN_SIGNAL_H
+#define SHUTDOWN_SIGNAL_H
+
+#include <functional>
+
+// 进程收到 SIGINT / SIGTERM（Windows 为 Ctrl+C / Ctrl+Break / 关闭控制台窗口）时，在普通线程上下文中调用当前注册的停止回调，
+// 使没有窗口（无法按 ESC）的实时会话也能正常收尾：写出逐目标汇总、最后一块轨迹与录制文件索引。
+// 回调不在信号处理函数里执行：POSIX 下所有线程屏蔽这两个信号，由专门线程 sigwait 接收；Windows 的控制台处理函数本身运行在独立线程。
+// 没有注册回调，或停止后再次收到信号时，按默认方式立即结束进程。
+namespace ShutdownSignal {
+    // 必须在 main 开头、创建任何线程之前调用：新线程继承信号屏蔽字
+    void install();
+    // 是否已收到过停止信号
+    bool requested();
+
+    // 作用域内收到信号时调用 on_stop（任意线程可调用的停止函数）；析构时注销，析构后不会再被调用
+    class Scope {
+    public:
+        explicit Scope(std::function<void()> on_stop);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+}
+
+#endif //SHUTDOWN_SIGNAL_H
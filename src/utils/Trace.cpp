@@ -0,0 +1,240 @@
+#include "Trace.h"
+#include "LatencyHistogram.h"
+#include "config/Configuration.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace Trace {
+    namespace {
+        constexpr int SPAN_COUNT = (int)Span::Count;
+        constexpr size_t EVENTS_PER_CHUNK = 4096;
+        constexpr size_t MAX_CHUNKS = (Config::TRACE_MAX_EVENTS_PER_THREAD + EVENTS_PER_CHUNK - 1) / EVENTS_PER_CHUNK;
+
+        const char* const SPAN_NAMES[SPAN_COUNT] = {
+            "capture", "wait.segment", "segment", "wait.label", "label", "wait.track", "track",
+            "wait.visualize", "visualize", "capture->display", "capture->actuation", "actuate", "serial.write"
+        };
+
+        struct Event {
+            int64_t begin_ns;    // 相对 Registry::epoch
+            int64_t duration_ns;
+            int32_t frame_idx;
+            uint8_t span;
+        };
+
+        using SpanHistograms = std::array<LatencyHistogram, SPAN_COUNT>;
+
+        // 每个线程一份。写入方只改 sets[active]，进出时各把 seq 加一（奇数表示正在写）；
+        // 汇总方先切换 active，再等 seq 变为偶数，此后旧的一组只归汇总方所有
+        struct Recorder {
+            std::string thread_name;
+            std::atomic<uint32_t> seq = {0};
+            std::atomic<int> active = {0};
+            std::array<SpanHistograms, 2> sets;
+            SpanHistograms total; // 仅汇总方访问
+
+            // Chrome trace 事件：按块追加，块指针与计数以 release 发布，导出方无需加锁
+            std::unique_ptr<std::atomic<Event*>[]> chunks;
+            std::atomic<size_t> event_count = {0};
+            std::atomic<uint64_t> events_dropped = {0};
+
+            ~Recorder() {
+                if (!chunks) return;
+                for (size_t c = 0; c < MAX_CHUNKS; ++c) delete[] chunks[c].load();
+            }
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<Recorder>> recorders;
+            const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        };
+
+        Registry& registry() {
+            static Registry instance;
+            return instance;
+        }
+
+        thread_local Recorder* t_recorder = nullptr;
+
+        Recorder& local() {
+            if (t_recorder) return *t_recorder;
+            auto recorder = std::make_unique<Recorder>();
+            if (!Config::TRACE_CHROME_PATH.empty()) {
+                recorder->chunks.reset(new std::atomic<Event*>[MAX_CHUNKS]);
+                for (size_t c = 0; c < MAX_CHUNKS; ++c) recorder->chunks[c].store(nullptr, std::memory_order_relaxed);
+            }
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            recorder->thread_name = "thread " + std::to_string(r.recorders.size());
+            t_recorder = recorder.get();
+            r.recorders.push_back(std::move(recorder));
+            return *t_recorder;
+        }
+
+        void append_event(Recorder& r, Span span, int64_t begin_ns, int64_t duration_ns, int frame_idx) {
+            const size_t n = r.event_count.load(std::memory_order_relaxed);
+            if (n >= MAX_CHUNKS * EVENTS_PER_CHUNK) {
+                r.events_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::atomic<Event*>& slot = r.chunks[n / EVENTS_PER_CHUNK];
+            Event* chunk = slot.load(std::memory_order_relaxed);
+            if (!chunk) {
+                chunk = new Event[EVENTS_PER_CHUNK];
+                slot.store(chunk, std::memory_order_release);
+            }
+            chunk[n % EVENTS_PER_CHUNK] = {begin_ns, duration_ns, (int32_t)frame_idx, (uint8_t)span};
+            r.event_count.store(n + 1, std::memory_order_release);
+        }
+
+        // 取走每个线程自上次汇总以来的直方图：合并进 interval 与该线程的累计值。调用方持有 registry 锁
+        void collect(Registry& registry, SpanHistograms& interval, std::array<int, SPAN_COUNT>& threads) {
+            threads.fill(0);
+            for (auto& recorder : registry.recorders) {
+                Recorder& r = *recorder;
+                const int old = r.active.load(std::memory_order_relaxed);
+                r.active.store(1 - old, std::memory_order_seq_cst);
+                while (r.seq.load(std::memory_order_seq_cst) & 1u) std::this_thread::yield();
+                for (int s = 0; s < SPAN_COUNT; ++s) {
+                    LatencyHistogram& h = r.sets[old][s];
+                    if (h.count() == 0) continue;
+                    interval[s].merge(h);
+                    r.total[s].merge(h);
+                    h.reset();
+                    threads[s]++;
+                }
+            }
+        }
+
+        void print(const char* title, const SpanHistograms& spans, const std::array<int, SPAN_COUNT>& threads) {
+            if (std::none_of(spans.begin(), spans.end(), [](const LatencyHistogram& h) { return h.count() > 0; })) return;
+            std::cout << "[Info] Stage latency (us, " << title << "):" << std::endl;
+            for (int s = 0; s < SPAN_COUNT; ++s) {
+                const LatencyHistogram& h = spans[s];
+                if (h.count() == 0) continue;
+                std::cout << "    " << std::left << std::setw(20) << SPAN_NAMES[s] << std::right
+                          << " n=" << std::setw(7) << h.count()
+                          << " p50=" << std::setw(8) << h.percentile(50)
+                          << " p99=" << std::setw(8) << h.percentile(99)
+                          << " max=" << std::setw(8) << h.max()
+                          << " threads=" << threads[s] << std::endl;
+            }
+        }
+    }
+
+    const char* span_name(Span span) {
+        return SPAN_NAMES[(int)span];
+    }
+
+    void name_thread(const std::string& name) {
+        if (!Config::TRACE_ENABLED) return;
+        Recorder& r = local();
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        r.thread_name = name;
+    }
+
+    void record(Span span, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end, int frame_idx) {
+        if (!Config::TRACE_ENABLED || begin == std::chrono::steady_clock::time_point{}) return;
+        Recorder& r = local();
+        const int64_t duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+
+        r.seq.fetch_add(1, std::memory_order_seq_cst);
+        const int active = r.active.load(std::memory_order_seq_cst);
+        r.sets[active][(int)span].record(duration_ns / 1000);
+        r.seq.fetch_add(1, std::memory_order_release);
+
+        if (r.chunks) {
+            const int64_t begin_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(begin - registry().epoch).count();
+            append_event(r, span, begin_ns, duration_ns, frame_idx);
+        }
+    }
+
+    void report(bool since_last) {
+        if (!Config::TRACE_ENABLED) return;
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        SpanHistograms interval;
+        std::array<int, SPAN_COUNT> threads;
+        collect(r, interval, threads);
+        if (since_last) {
+            print("since last report", interval, threads);
+            return;
+        }
+        SpanHistograms total;
+        threads.fill(0);
+        for (const auto& recorder : r.recorders) {
+            for (int s = 0; s < SPAN_COUNT; ++s) {
+                if (recorder->total[s].count() == 0) continue;
+                total[s].merge(recorder->total[s]);
+                threads[s]++;
+            }
+        }
+        print("total", total, threads);
+    }
+
+    bool write_chrome_trace(const std::string& path) {
+        if (!Config::TRACE_ENABLED || Config::TRACE_CHROME_PATH.empty()) return false;
+        std::error_code ec;
+        const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent, ec);
+        std::ofstream out(path);
+        if (!out.is_open()) {
+            std::cerr << "[Warning] Could not write trace file " << path << std::endl;
+            return false;
+        }
+
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        uint64_t events = 0, dropped = 0;
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        auto separator = [&] { out << (first ? "" : ",\n"); first = false; };
+        out << std::fixed << std::setprecision(3);
+        for (size_t tid = 0; tid < r.recorders.size(); ++tid) {
+            const Recorder& rec = *r.recorders[tid];
+            separator();
+            out << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"name\":\"thread_name\",\"args\":{\"name\":\"" << rec.thread_name << "\"}}";
+            const size_t count = rec.event_count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; ++i) {
+                const Event& e = rec.chunks[i / EVENTS_PER_CHUNK].load(std::memory_order_acquire)[i % EVENTS_PER_CHUNK];
+                separator();
+                out << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << tid << ",\"name\":\"" << SPAN_NAMES[e.span]
+                    << "\",\"ts\":" << e.begin_ns / 1000.0 << ",\"dur\":" << e.duration_ns / 1000.0;
+                if (e.frame_idx >= 0) out << ",\"args\":{\"frame\":" << e.frame_idx << "}";
+                out << "}";
+            }
+            events += count;
+            dropped += rec.events_dropped.load(std::memory_order_relaxed);
+        }
+        out << "\n]}\n";
+        std::cout << "[Info] Wrote " << events << " trace events to " << path;
+        if (dropped) std::cout << " (" << dropped << " dropped, raise TRACE_MAX_EVENTS_PER_THREAD)";
+        std::cout << std::endl;
+        return true;
+    }
+
+    Reporter::Reporter(std::chrono::milliseconds interval) : m_interval(interval) {
+        if (!Config::TRACE_ENABLED || interval.count() <= 0) return;
+        m_thread = std::thread([this] {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (!m_cv.wait_for(lock, m_interval, [this] { return m_stop; })) report(true);
+        });
+    }
+
+    Reporter::~Reporter() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        if (m_thread.joinable()) m_thread.join();
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// 逐段延迟统计：各流水线线程把“某一段从 begin 到 end”记入本线程私有的 LatencyHistogram（微秒），
+// 记录路径无锁、无分配（写入方只做两次原子自增；汇总方切换双缓冲后等待写入方离开临界段）。
+// 汇总时按段合并所有线程，输出 p50 / p99 / max，用于按产线估算所需硬件。
+// 开启 Config::TRACE_CHROME_PATH 时同时保留逐次事件，退出时导出为 Chrome trace（chrome://tracing / Perfetto）。
+namespace Trace {
+    enum class Span : uint8_t {
+        Capture,          // 读图 / 等待相机出帧
+        WaitSegment,      // 采集 -> 分割开始（输入队列）
+        Segment,
+        WaitLabel,        // 分割 -> 标记（分割队列）
+        Label,
+        WaitTrack,        // 标记 -> 跟踪（重排缓冲区）
+        Track,
+        WaitVisualize,    // 跟踪 -> 显示（显示队列）
+        Visualize,        // 绘制 + imshow
+        CaptureToDisplay, // 端到端：采集 -> 显示完成
+        CaptureToActuation, // 端到端：采集 -> 执行器命令发出
+        Actuate,          // 触发回调（入发送队列）
+        SerialWrite,      // 发送线程单次写串口
+        Count
+    };
+
+    const char* span_name(Span span);
+
+    // 为当前线程命名（报告与 Chrome trace 中显示），首次记录前调用
+    void name_thread(const std::string& name);
+
+    // 记录一段耗时；begin 为默认值（该边界未打点）时忽略。Config::TRACE_ENABLED 为 false 时直接返回
+    void record(Span span, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end, int frame_idx = -1);
+
+    // 汇总并打印：since_last 为 true 时只统计上次打印以来的区间，否则为启动以来的累计
+    void report(bool since_last);
+
+    // 写出 Chrome trace JSON；未开启事件记录或写文件失败返回 false
+    bool write_chrome_trace(const std::string& path);
+
+    // 后台按固定间隔打印区间统计；析构时停止
+    class Reporter {
+    public:
+        explicit Reporter(std::chrono::milliseconds interval);
+        ~Reporter();
+        Reporter(const Reporter&) = delete;
+        Reporter& operator=(const Reporter&) = delete;
+
+    private:
+        std::chrono::milliseconds m_interval;
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        bool m_stop = false;
+        std::thread m_thread;
+    };
+}
+
+#endif //TRACE_H
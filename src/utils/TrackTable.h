@@ -0,0 +1,192 @@
+#ifndef TRACKTABLE_H
+#define TRACKTABLE_H
+
+#include "DataTypes.h"
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// 结构数组（SoA）形式的轨迹表。
+// - 每个字段一列连续存储，预测、门限、丢失计数等逐轨迹操作都是对连续数组的简单循环
+// - 行按分区（ROI）连续排列：分区 p 占据 [begin(p), end(p))，按 ROI 处理时无需扫描全表
+// - 删除为分区内 swap-remove，插入 / 删除各需 O(分区数) 次行交换
+// - 行号会随删除而变化；需要长期引用某条轨迹时使用 Handle（槽位 + 代数，删除后自动失效）
+class TrackTable {
+public:
+    struct Handle {
+        uint32_t slot = UINT32_MAX;
+        uint32_t generation = 0;
+        bool operator==(const Handle& other) const { return slot == other.slot && generation == other.generation; }
+    };
+
+    struct Columns {
+        std::vector<int> unique_id;
+        std::vector<int> assigned_number;
+        std::vector<int> missed_frames;
+        std::vector<int> label_id;
+        std::vector<float> centroid_x, centroid_y;
+        std::vector<float> velocity_x, velocity_y;
+        std::vector<cv::Rect> bbox;
+        std::vector<cv::Scalar> color;
+        // 卡尔曼模式的附加状态：x / y 两轴的 2x2 位置-速度协方差相同，只存一份；bbox 宽高为随机游走
+        std::vector<float> cov_pp, cov_pv, cov_vv;
+        std::vector<float> size_w, size_h, size_var;
+        // 最后一次被检测到时的位置与采集时刻（卡尔曼模式的质心列在丢失期间会继续外推）
+        std::vector<float> seen_x, seen_y;
+        std::vector<std::chrono::steady_clock::time_point> seen_time;
+
+        template<typename F>
+        void for_each(F&& f) {
+            f(unique_id); f(assigned_number); f(missed_frames); f(label_id);
+            f(centroid_x); f(centroid_y); f(velocity_x); f(velocity_y);
+            f(bbox); f(color);
+            f(cov_pp); f(cov_pv); f(cov_vv);
+            f(size_w); f(size_h); f(size_var);
+            f(seen_x); f(seen_y); f(seen_time);
+        }
+    };
+
+    explicit TrackTable(int partitions = 1) : m_offsets(partitions + 1, 0) {}
+
+    int partition_count() const { return (int)m_offsets.size() - 1; }
+    int size() const { return m_offsets.back(); }
+    bool empty() const { return size() == 0; }
+    int begin(int partition) const { return m_offsets[partition]; }
+    int end(int partition) const { return m_offsets[partition + 1]; }
+
+    Columns& columns() { return m_columns; }
+    const Columns& columns() const { return m_columns; }
+
+    // 追加到指定分区末尾，返回稳定句柄
+    Handle insert(int partition, const TrackedObject& obj) {
+        Handle handle = allocate_handle();
+        Columns& c = m_columns;
+        c.unique_id.push_back(obj.unique_id);
+        c.assigned_number.push_back(obj.assigned_number);
+        c.missed_frames.push_back(obj.missed_frames);
+        c.label_id.push_back(obj.current_label_id);
+        c.centroid_x.push_back(obj.centroid.x);
+        c.centroid_y.push_back(obj.centroid.y);
+        c.velocity_x.push_back(obj.velocity.x);
+        c.velocity_y.push_back(obj.velocity.y);
+        c.bbox.push_back(obj.current_bbox);
+        c.color.push_back(obj.color);
+        c.cov_pp.push_back(0.0f);
+        c.cov_pv.push_back(0.0f);
+        c.cov_vv.push_back(0.0f);
+        c.size_w.push_back((float)obj.current_bbox.width);
+        c.size_h.push_back((float)obj.current_bbox.height);
+        c.size_var.push_back(0.0f);
+        c.seen_x.push_back(obj.centroid.x);
+        c.seen_y.push_back(obj.centroid.y);
+        c.seen_time.push_back({});
+        m_handles.push_back(handle);
+        int pos = m_offsets.back()++;
+        m_slot_index[handle.slot] = pos;
+
+        // 新行从表尾逐个分区向前挪：与后续每个分区的首行交换
+        for (int q = partition_count() - 1; q > partition; --q) {
+            swap_rows(m_offsets[q], pos);
+            pos = m_offsets[q]++;
+        }
+        return handle;
+    }
+
+    // 删除第 index 行：先与本分区末行交换，再把空位逐个分区推到表尾
+    void erase_at(int index) {
+        int p = partition_of(index);
+        int pos = m_offsets[p + 1] - 1;
+        swap_rows(index, pos);
+        m_offsets[p + 1]--;
+        for (int q = p + 1; q < partition_count(); ++q) {
+            const int last = m_offsets[q + 1] - 1;
+            swap_rows(pos, last);
+            pos = last;
+            m_offsets[q + 1]--;
+        }
+        release_handle(m_handles[pos]);
+        pop_back();
+    }
+
+    bool erase(Handle handle) {
+        const int index = index_of(handle);
+        if (index < 0) return false;
+        erase_at(index);
+        return true;
+    }
+
+    // 句柄失效（轨迹已删除）时返回 -1
+    int index_of(Handle handle) const {
+        if (handle.slot >= m_slot_generation.size() || m_slot_generation[handle.slot] != handle.generation) return -1;
+        return m_slot_index[handle.slot];
+    }
+
+    Handle handle_at(int index) const { return m_handles[index]; }
+
+    int partition_of(int index) const {
+        int p = 0;
+        while (index >= m_offsets[p + 1]) ++p;
+        return p;
+    }
+
+    // 按行组装 AoS 视图（供显示快照等低频路径使用）
+    TrackedObject object_at(int index) const {
+        const Columns& c = m_columns;
+        TrackedObject obj;
+        obj.unique_id = c.unique_id[index];
+        obj.assigned_number = c.assigned_number[index];
+        obj.missed_frames = c.missed_frames[index];
+        obj.centroid = {c.centroid_x[index], c.centroid_y[index]};
+        obj.velocity = {c.velocity_x[index], c.velocity_y[index]};
+        obj.color = c.color[index];
+        obj.current_label_id = c.label_id[index];
+        obj.current_bbox = c.bbox[index];
+        return obj;
+    }
+
+    void clear() {
+        while (!empty()) erase_at(size() - 1);
+    }
+
+private:
+    void swap_rows(int a, int b) {
+        if (a == b) return;
+        m_columns.for_each([a, b](auto& column) { std::swap(column[a], column[b]); });
+        std::swap(m_handles[a], m_handles[b]);
+        m_slot_index[m_handles[a].slot] = a;
+        m_slot_index[m_handles[b].slot] = b;
+    }
+
+    void pop_back() {
+        m_columns.for_each([](auto& column) { column.pop_back(); });
+        m_handles.pop_back();
+    }
+
+    Handle allocate_handle() {
+        if (!m_free_slots.empty()) {
+            const uint32_t slot = m_free_slots.back();
+            m_free_slots.pop_back();
+            return {slot, m_slot_generation[slot]};
+        }
+        m_slot_generation.push_back(0);
+        m_slot_index.push_back(-1);
+        return {(uint32_t)m_slot_generation.size() - 1, 0};
+    }
+
+    void release_handle(Handle handle) {
+        m_slot_generation[handle.slot]++;
+        m_slot_index[handle.slot] = -1;
+        m_free_slots.push_back(handle.slot);
+    }
+
+    Columns m_columns;
+    std::vector<Handle> m_handles;          // 行 -> 句柄
+    std::vector<int> m_offsets;             // 分区边界，大小为分区数 + 1
+    std::vector<uint32_t> m_slot_generation;
+    std::vector<int> m_slot_index;          // 槽位 -> 行
+    std::vector<uint32_t> m_free_slots;
+};
+
+#endif //TRACKTABLE_H
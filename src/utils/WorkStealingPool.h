@@ -0,0 +1,149 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 工作窃取线程池：每个工作线程一条双端队列。
+// - 工作线程内提交的任务压入自己队列的尾部并优先从尾部取（LIFO，数据还在缓存里）
+// - 外部线程提交的任务轮流分给各工作线程
+// - 自己的队列空了就从其他线程队列的头部窃取（FIFO，取走最早、通常也最大的任务）
+// 每条队列一把只在入队 / 出队瞬间持有的小锁；全部空闲时线程在条件变量上休眠，不轮询。
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    struct Counters {
+        uint64_t executed = 0;
+        uint64_t stolen = 0; // 从其他线程队列窃取执行的任务数
+    };
+
+    explicit WorkStealingPool(unsigned int threads = 0) {
+        if (threads == 0) threads = (std::max)(1u, std::thread::hardware_concurrency());
+        for (unsigned int i = 0; i < threads; ++i) m_queues.push_back(std::make_unique<Queue>());
+        for (unsigned int i = 0; i < threads; ++i) m_threads.emplace_back([this, i] { worker(i); });
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto& t : m_threads) t.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned int size() const { return (unsigned int)m_threads.size(); }
+
+    void submit(Task task) {
+        const int self = t_worker_pool == this ? t_worker_index : -1;
+        Queue& q = self >= 0 ? *m_queues[self] : *m_queues[m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size()];
+        m_unfinished.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(std::move(task));
+        }
+        m_pending.fetch_add(1, std::memory_order_seq_cst);
+        if (m_sleeping.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+            m_wake.notify_one();
+        }
+    }
+
+    // 阻塞直到所有已提交的任务（包括任务中继续提交的任务）执行完毕
+    void wait_idle() {
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        m_idle.wait(lock, [this] { return m_unfinished.load(std::memory_order_acquire) == 0; });
+    }
+
+    Counters counters() const {
+        Counters c;
+        c.executed = m_executed.load(std::memory_order_relaxed);
+        c.stolen = m_stolen.load(std::memory_order_relaxed);
+        return c;
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool take(unsigned int self, Task& task) {
+        {
+            Queue& own = *m_queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        const size_t n = m_queues.size();
+        for (size_t k = 1; k < n; ++k) {
+            Queue& victim = *m_queues[(self + k) % n];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                m_stolen.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void worker(unsigned int self) {
+        t_worker_pool = this;
+        t_worker_index = (int)self;
+        Task task;
+        while (true) {
+            if (take(self, task)) {
+                m_pending.fetch_sub(1, std::memory_order_relaxed);
+                task();
+                task = nullptr;
+                m_executed.fetch_add(1, std::memory_order_relaxed);
+                if (m_unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard<std::mutex> lock(m_sleep_mutex);
+                    m_idle.notify_all();
+                }
+                continue;
+            }
+            // 与 submit 构成 Dekker 式配对：要么提交方看到有人在睡，要么这里看到新任务
+            std::unique_lock<std::mutex> lock(m_sleep_mutex);
+            m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+            m_wake.wait(lock, [this] { return m_stop || m_pending.load(std::memory_order_seq_cst) > 0; });
+            m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+            if (m_stop && m_pending.load(std::memory_order_relaxed) == 0) return;
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<size_t> m_next_queue = {0};
+    std::atomic<int64_t> m_pending = {0};    // 已入队未取走
+    std::atomic<int64_t> m_unfinished = {0}; // 已提交未执行完
+    std::atomic<int> m_sleeping = {0};
+    std::atomic<uint64_t> m_executed = {0};
+    std::atomic<uint64_t> m_stolen = {0};
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    bool m_stop = false;
+
+    static inline thread_local WorkStealingPool* t_worker_pool = nullptr;
+    static inline thread_local int t_worker_index = -1;
+};
+
+#endif //WORKSTEALINGPOOL_H